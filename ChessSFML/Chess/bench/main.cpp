@@ -0,0 +1,628 @@
+/**
+ * @file main.cpp
+ * @brief Command line micro-benchmarks for the board core
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Usage:
+ *   bench attacks [--rounds N]
+ *   bench status [--positions N] [--threads N]
+ *   bench search [--depth N] [--hash MB]
+ *   bench smp [--depth N] [--hash MB] [--threads N]
+ *
+ * attacks: builds whole-board slider attack maps for positions taken from
+ * the perft reference suite with every available method (ray walking,
+ * per-piece magic lookups and the Kogge-Stone kernels) and reports the
+ * time per map. The exit code is non-zero if two methods disagree.
+ *
+ * status: classifies positions reached from the perft reference suite
+ * with PositionBatch and, for comparison, with one ChessBoard per
+ * position, and reports positions per second. The exit code is non-zero
+ * if the two disagree, a position does not come back from the batch
+ * exactly as it was added, or a deliberately broken position is not
+ * classified as illegal.
+ *
+ * search: runs the engine to a fixed depth on every perft reference
+ * position and reports nodes and nodes per second. Fixed depth keeps the
+ * node counts identical between runs, so the totals track search
+ * throughput from one release to the next. The transposition table is
+ * cleared before each position, and its hit rate is reported with the
+ * node counts, as is the share of fail-high nodes that cut off on their
+ * first move, which measures move ordering.
+ *
+ * smp: searches the same positions to the same depth with 1, 2, 4, 8...
+ * threads up to --threads, in Lazy SMP and in YBWC mode, and reports for
+ * each the time to reach the depth, nodes per second, the speedup over
+ * one thread and the search overhead (extra nodes over one thread).
+ * Helper threads make node counts vary from run to run, so the numbers
+ * are only comparable within one report.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Attacks.h"
+#include "Engine.h"
+#include "Perft.h"
+#include "PositionBatch.h"
+
+namespace {
+    /**
+     * @brief Sliders of one side and the board occupancy
+     */
+    struct SliderSample {
+        Bitboard orthogonal;  ///< Rooks and queens
+        Bitboard diagonal;    ///< Bishops and queens
+        Bitboard occupancy;   ///< Occupied squares
+    };
+
+    /**
+     * @brief Records the sliders of both sides of the current position
+     * @param board Position to sample
+     * @param samples List the samples are appended to
+     */
+    void addSamples(const ChessBoard& board, std::vector<SliderSample>& samples) {
+        Bitboard occupancy = board.getOccupied();
+        for (PieceColor color : { PieceColor::WHITE, PieceColor::BLACK }) {
+            Bitboard queens = board.getPieces(PieceType::QUEEN, color);
+            samples.push_back({ board.getPieces(PieceType::ROOK, color) | queens,
+                board.getPieces(PieceType::BISHOP, color) | queens, occupancy });
+        }
+    }
+
+    /**
+     * @brief Samples every position up to two plies from the reference positions
+     * @return Slider samples
+     */
+    std::vector<SliderSample> collectSamples() {
+        std::vector<SliderSample> samples;
+        ChessBoard board;
+        for (const PerftCase& test : Perft::referenceSuite()) {
+            board.loadFen(test.fen);
+            addSamples(board, samples);
+
+            MoveList moves;
+            board.generateLegalMoves(moves);
+            for (const Move& move : moves) {
+                board.makeLegalMove(move);
+                addSamples(board, samples);
+
+                MoveList replies;
+                board.generateLegalMoves(replies);
+                for (const Move& reply : replies) {
+                    board.makeLegalMove(reply);
+                    addSamples(board, samples);
+                    board.unmakeMove();
+                }
+                board.unmakeMove();
+            }
+        }
+        return samples;
+    }
+
+    /**
+     * @brief Attack map built the way the piece classes used to do it
+     *
+     * Every slider walks each of its directions one square at a time with
+     * a bounds check per step, stopping at the first occupied square.
+     *
+     * @param sample Sliders and occupancy
+     * @return Attacked squares
+     */
+    Bitboard rayWalk(const SliderSample& sample) {
+        static const int directions[8][2] = {
+            {-1, 0}, {0, 1}, {1, 0}, {0, -1},
+            {-1, -1}, {-1, 1}, {1, -1}, {1, 1}
+        };
+
+        Bitboard attacks = 0;
+        Bitboard sliders = sample.orthogonal | sample.diagonal;
+        while (sliders) {
+            int square = popLsb(sliders);
+            int first = (sample.orthogonal & squareBB(square)) ? 0 : 4;
+            int last = (sample.diagonal & squareBB(square)) ? 8 : 4;
+            for (int d = first; d < last; d++) {
+                int r = rowOf(square) + directions[d][0];
+                int c = colOf(square) + directions[d][1];
+                for (; r >= 0 && r < 8 && c >= 0 && c < 8; r += directions[d][0], c += directions[d][1]) {
+                    attacks |= squareBB(makeSquare(r, c));
+                    if (sample.occupancy & squareBB(makeSquare(r, c))) {
+                        break;
+                    }
+                }
+            }
+        }
+        return attacks;
+    }
+
+    /**
+     * @brief Attack map built from one magic lookup per slider
+     * @param sample Sliders and occupancy
+     * @return Attacked squares
+     */
+    Bitboard magicLookups(const SliderSample& sample) {
+        Bitboard attacks = 0;
+        for (Bitboard rooks = sample.orthogonal; rooks; ) {
+            attacks |= Attacks::rook(popLsb(rooks), sample.occupancy);
+        }
+        for (Bitboard bishops = sample.diagonal; bishops; ) {
+            attacks |= Attacks::bishop(popLsb(bishops), sample.occupancy);
+        }
+        return attacks;
+    }
+
+    /**
+     * @brief Attack map from Attacks::slidingAttacks() with the selected kernel
+     * @param sample Sliders and occupancy
+     * @return Attacked squares
+     */
+    Bitboard koggeStone(const SliderSample& sample) {
+        return Attacks::slidingAttacks(sample.orthogonal, sample.diagonal, sample.occupancy);
+    }
+
+    /**
+     * @brief Times one attack map method over every sample
+     * @param name Label printed for the method
+     * @param method Function building one attack map
+     * @param samples Positions to map
+     * @param rounds Number of passes over the samples
+     * @param expected Checksum of the reference method, 0 to skip the check
+     * @return Checksum of all maps
+     */
+    template <typename Method>
+    Bitboard runMethod(const char* name, Method method, const std::vector<SliderSample>& samples, int rounds, Bitboard expected) {
+        Bitboard checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (const SliderSample& sample : samples) {
+                checksum += method(sample);
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double maps = static_cast<double>(samples.size()) * rounds;
+        std::cout << std::left << std::setw(28) << name << std::right
+            << std::fixed << std::setprecision(2)
+            << std::setw(10) << seconds * 1e9 / maps << " ns/map"
+            << std::setw(10) << maps / seconds / 1e6 << " M maps/s";
+        if (expected != 0 && checksum != expected) {
+            std::cout << "  MISMATCH";
+        }
+        std::cout << '\n';
+        return checksum;
+    }
+
+    /**
+     * @brief Benchmarks the whole-board slider attack methods
+     * @param rounds Number of passes over the sample positions
+     * @return Process exit code, 0 if every method produced the same maps
+     */
+    int benchAttacks(int rounds) {
+        std::vector<SliderSample> samples = collectSamples();
+        std::cout << samples.size() << " attack maps x " << rounds << " rounds\n\n";
+
+        Bitboard expected = runMethod("ray walk (per piece)", rayWalk, samples, rounds, 0);
+        bool agree = runMethod("magic lookups (per piece)", magicLookups, samples, rounds, expected) == expected;
+
+        FillKernel initial = Attacks::getFillKernel();
+        const struct {
+            FillKernel kernel;
+            const char* name;
+        } kernels[] = {
+            { FillKernel::SCALAR, "Kogge-Stone scalar" },
+            { FillKernel::SSE2,   "Kogge-Stone SSE2" },
+            { FillKernel::AVX2,   "Kogge-Stone AVX2" },
+        };
+        for (const auto& entry : kernels) {
+            if (!Attacks::setFillKernel(entry.kernel)) {
+                std::cout << std::left << std::setw(28) << entry.name << std::right << "   not supported on this CPU\n";
+                continue;
+            }
+            agree = runMethod(entry.name, koggeStone, samples, rounds, expected) == expected && agree;
+        }
+        Attacks::setFillKernel(initial);
+
+        return agree ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /**
+     * @brief Collects every position within a number of plies of the board's position
+     * @param board Position to start from, returned unchanged
+     * @param depth Number of plies still to play
+     * @param positions Receives the positions
+     */
+    void addTree(ChessBoard& board, int depth, std::vector<Position>& positions) {
+        positions.push_back(board.getPosition());
+        if (depth == 0) {
+            return;
+        }
+
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        for (const Move& move : moves) {
+            board.makeLegalMove(move);
+            addTree(board, depth - 1, positions);
+            board.unmakeMove();
+        }
+    }
+
+    /**
+     * @brief Compares two positions field by field
+     *
+     * Position has padding, so memcmp would also compare bytes no one set.
+     *
+     * @return true if every field matches
+     */
+    bool samePosition(const Position& a, const Position& b) {
+        for (int type = 0; type < 7; type++) {
+            if (a.typeBB[type] != b.typeBB[type]) {
+                return false;
+            }
+        }
+        return a.colorBB[0] == b.colorBB[0] && a.colorBB[1] == b.colorBB[1] && a.key == b.key &&
+            a.kingSquares[0] == b.kingSquares[0] && a.kingSquares[1] == b.kingSquares[1] &&
+            a.enPassantCol == b.enPassantCol && a.enPassantRow == b.enPassantRow &&
+            a.castlingRights == b.castlingRights && a.sideToMove == b.sideToMove &&
+            a.halfmoveClock == b.halfmoveClock && a.middlegameScore == b.middlegameScore &&
+            a.endgameScore == b.endgameScore && a.phase == b.phase;
+    }
+
+    /**
+     * @brief Builds positions that PositionBatch must reject
+     *
+     * One position per sanity rule: a missing king, a second king, a pawn
+     * on the last row, the side that just moved left in check, a square in
+     * both color sets, and an occupied square without a piece type.
+     *
+     * @return Positions that are all illegal
+     */
+    std::vector<Position> brokenPositions() {
+        const char* fens[] = {
+            "8/8/8/8/8/8/8/4K3 w - - 0 1",                // no black king
+            "4k3/8/8/8/8/8/8/K3K3 w - - 0 1",             // two white kings
+            "P3k3/8/8/8/8/8/8/4K3 b - - 0 1",             // white pawn on the last row
+            "4k3/8/8/8/8/8/8/4R1K1 w - - 0 1"             // black, not to move, is in check
+        };
+
+        std::vector<Position> broken;
+        ChessBoard board;
+        for (const char* fen : fens) {
+            board.loadFen(fen);
+            broken.push_back(board.getPosition());
+        }
+
+        board.loadFen("4k3/8/8/8/8/8/3P4/4K3 w - - 0 1");
+        Position overlapping = board.getPosition();
+        overlapping.colorBB[1] |= overlapping.colorBB[0] & overlapping.typeBB[static_cast<int>(PieceType::PAWN)];
+        broken.push_back(overlapping);
+
+        Position untyped = board.getPosition();
+        untyped.typeBB[0] |= squareBB(makeSquare(4, 4));
+        untyped.colorBB[0] |= squareBB(makeSquare(4, 4));
+        broken.push_back(untyped);
+        return broken;
+    }
+
+    /**
+     * @brief Classifies a position the way a caller without batches would
+     *
+     * Builds a fresh ChessBoard for the position, as a job classifying
+     * positions one at a time does.
+     *
+     * @param position Position to classify
+     * @param moveCount Receives the number of legal moves
+     * @return Classification (never ILLEGAL; the position must be legal)
+     */
+    PositionState classifySingle(const Position& position, int& moveCount) {
+        ChessBoard board;
+        board.setPosition(position);
+        GameStatus status = board.evaluateStatus(position.sideToMove);
+        moveCount = status.legalMoveCount;
+        if (status.checkmate) {
+            return PositionState::CHECKMATE;
+        }
+        if (status.stalemate) {
+            return PositionState::STALEMATE;
+        }
+        return status.inCheck ? PositionState::CHECK : PositionState::PLAYING;
+    }
+
+    /**
+     * @brief Benchmarks batched position classification
+     * @param positions Number of positions to classify
+     * @param threads Number of worker threads for the batch
+     * @return Process exit code, 0 if batch and single-board results agree
+     */
+    int benchStatus(std::size_t positions, int threads) {
+        // Distinct positions up to three plies from each reference
+        // position, repeated until the batch is full
+        std::vector<Position> positionsFound;
+        ChessBoard board;
+        for (const PerftCase& test : Perft::referenceSuite()) {
+            board.loadFen(test.fen);
+            addTree(board, 3, positionsFound);
+        }
+
+        // Every field, the evaluation sums included, must survive the
+        // trip through the columns
+        PositionBatch distinct;
+        distinct.reserve(positionsFound.size());
+        for (const Position& position : positionsFound) {
+            distinct.add(position);
+        }
+        std::size_t roundTripErrors = 0;
+        for (std::size_t i = 0; i < distinct.size(); i++) {
+            if (!samePosition(distinct.get(i), positionsFound[i])) {
+                roundTripErrors++;
+            }
+        }
+
+        // The reference positions are all legal, so the rejection rules
+        // get positions of their own
+        PositionBatch broken;
+        for (const Position& position : brokenPositions()) {
+            broken.add(position);
+        }
+        BatchStatus brokenStatus;
+        broken.evaluate(brokenStatus, 1);
+        std::size_t missedIllegal = 0;
+        for (std::size_t i = 0; i < broken.size(); i++) {
+            if (brokenStatus.state[i] != PositionState::ILLEGAL || brokenStatus.moveCount[i] != 0) {
+                missedIllegal++;
+            }
+        }
+
+        PositionBatch batch;
+        batch.reserve(positions);
+        for (std::size_t i = 0; i < positions; i++) {
+            batch.add(distinct.get(i % distinct.size()));
+        }
+        std::cout << batch.size() << " positions (" << distinct.size() << " distinct), "
+            << threads << (threads == 1 ? " thread" : " threads") << "\n\n";
+
+        BatchStatus status;
+        auto start = std::chrono::steady_clock::now();
+        batch.evaluate(status, threads);
+        double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::size_t mismatches = 0;
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            int moveCount = 0;
+            PositionState state = classifySingle(batch.get(i), moveCount);
+            if (state != status.state[i] || moveCount != status.moveCount[i]) {
+                mismatches++;
+            }
+        }
+        double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::size_t counts[5] = {};
+        for (PositionState state : status.state) {
+            counts[static_cast<int>(state)]++;
+        }
+
+        double count = static_cast<double>(batch.size());
+        std::cout << std::fixed << std::setprecision(0)
+            << "PositionBatch             " << std::setw(12) << count / batchSeconds << " positions/s\n"
+            << "ChessBoard per position   " << std::setw(12) << count / singleSeconds << " positions/s (1 thread)\n\n"
+            << "playing " << counts[static_cast<int>(PositionState::PLAYING)]
+            << ", check " << counts[static_cast<int>(PositionState::CHECK)]
+            << ", checkmate " << counts[static_cast<int>(PositionState::CHECKMATE)]
+            << ", stalemate " << counts[static_cast<int>(PositionState::STALEMATE)]
+            << ", illegal " << counts[static_cast<int>(PositionState::ILLEGAL)] << '\n';
+
+        if (missedIllegal != 0) {
+            std::cout << missedIllegal << " of " << broken.size() << " broken positions not classified as illegal" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (roundTripErrors != 0) {
+            std::cout << roundTripErrors << " positions changed on the way through the batch" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (mismatches != 0) {
+            std::cout << mismatches << " positions classified differently" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Batch and single-board results agree" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    /**
+     * @brief Benchmarks the engine search at a fixed depth
+     * @param depth Iteration depth for every position
+     * @param hashMB Transposition table size in megabytes
+     * @return Process exit code, 0 if every position got a move
+     */
+    int benchSearch(int depth, int hashMB) {
+        Engine engine;
+        engine.setHashSize(static_cast<std::size_t>(hashMB));
+        ChessBoard board;
+        std::uint64_t totalNodes = 0;
+        std::uint64_t totalProbes = 0;
+        std::uint64_t totalHits = 0;
+        std::uint64_t totalCutoffs = 0;
+        std::uint64_t totalFirstMoveCutoffs = 0;
+        double totalSeconds = 0;
+        bool allMoves = true;
+
+        std::cout << "depth " << depth << ", hash " << hashMB << " MB\n\n";
+        for (const PerftCase& test : Perft::referenceSuite()) {
+            board.loadFen(test.fen);
+            engine.clearHash();
+            SearchInfo info = engine.search(board, { depth, 0 });
+            totalNodes += info.nodes;
+            totalProbes += info.hashProbes;
+            totalHits += info.hashHits;
+            totalCutoffs += info.cutoffs;
+            totalFirstMoveCutoffs += info.firstMoveCutoffs;
+            totalSeconds += info.seconds;
+
+            bool hasMoves = !board.getLegalMoves().empty();
+            allMoves = allMoves && (info.bestMove.isNone() != hasMoves);
+            std::cout << std::left << std::setw(32) << test.name << std::right
+                << std::setw(8) << (info.bestMove.isNone() ? "-" : Perft::moveToString(info.bestMove))
+                << std::setw(8) << info.score
+                << std::setw(12) << info.nodes << " nodes"
+                << std::setw(12) << info.nodesPerSecond() << " nps"
+                << std::setw(8) << static_cast<int>(info.hashHitRate() * 100 + 0.5) << "% hash hits"
+                << std::setw(8) << static_cast<int>(info.firstMoveCutoffRate() * 100 + 0.5) << "% first-move cutoffs\n";
+        }
+
+        std::cout << "\nTotal: " << totalNodes << " nodes in " << std::fixed << std::setprecision(3) << totalSeconds
+            << " s, " << std::setprecision(0) << (totalSeconds > 0 ? totalNodes / totalSeconds : 0.0) << " nps, "
+            << std::setprecision(1) << (totalProbes > 0 ? 100.0 * totalHits / totalProbes : 0.0) << "% hash hits, "
+            << (totalCutoffs > 0 ? 100.0 * totalFirstMoveCutoffs / totalCutoffs : 0.0) << "% first-move cutoffs" << std::endl;
+        return allMoves ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /**
+     * @brief Measures how the engine search scales with threads
+     * @param depth Iteration depth for every position
+     * @param hashMB Transposition table size in megabytes
+     * @param maxThreads Largest thread count measured
+     * @return Process exit code, 0 if every search got a move
+     */
+    int benchSmp(int depth, int hashMB, int maxThreads) {
+        std::vector<int> threadCounts;
+        for (int count = 1; count < maxThreads; count *= 2) {
+            threadCounts.push_back(count);
+        }
+        threadCounts.push_back(maxThreads);
+
+        const struct {
+            ParallelMode mode;
+            const char* name;
+        } modes[] = {
+            { ParallelMode::LAZY_SMP, "lazy" },
+            { ParallelMode::YBWC, "ybwc" }
+        };
+
+        Engine engine;
+        engine.setHashSize(static_cast<std::size_t>(hashMB));
+        ChessBoard board;
+        bool allMoves = true;
+
+        std::cout << "depth " << depth << ", hash " << hashMB << " MB, "
+            << std::thread::hardware_concurrency() << " hardware threads\n\n"
+            << std::setw(6) << "mode" << std::setw(9) << "threads" << std::setw(12) << "seconds" << std::setw(14) << "nodes"
+            << std::setw(12) << "nps" << std::setw(10) << "speedup" << std::setw(10) << "overhead" << '\n';
+        for (const auto& mode : modes) {
+            engine.setParallelMode(mode.mode);
+            double baseSeconds = 0;
+            std::uint64_t baseNodes = 0;
+            for (int count : threadCounts) {
+                engine.setThreads(count);
+                std::uint64_t totalNodes = 0;
+                double totalSeconds = 0;
+                for (const PerftCase& test : Perft::referenceSuite()) {
+                    board.loadFen(test.fen);
+                    engine.clearHash();
+                    SearchInfo info = engine.search(board, { depth, 0 });
+                    totalNodes += info.nodes;
+                    totalSeconds += info.seconds;
+
+                    bool hasMoves = !board.getLegalMoves().empty();
+                    allMoves = allMoves && (info.bestMove.isNone() != hasMoves);
+                }
+
+                if (count == 1) {
+                    baseSeconds = totalSeconds;
+                    baseNodes = totalNodes;
+                }
+                std::cout << std::setw(6) << mode.name << std::setw(9) << count
+                    << std::setw(12) << std::fixed << std::setprecision(3) << totalSeconds
+                    << std::setw(14) << totalNodes
+                    << std::setw(12) << std::setprecision(0) << (totalSeconds > 0 ? totalNodes / totalSeconds : 0.0)
+                    << std::setw(9) << std::setprecision(2) << (totalSeconds > 0 ? baseSeconds / totalSeconds : 0.0) << "x"
+                    << std::setw(9) << std::setprecision(1) << (baseNodes > 0 ? 100.0 * totalNodes / baseNodes - 100.0 : 0.0) << "%"
+                    << std::endl;
+            }
+        }
+        return allMoves ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /**
+     * @brief Prints the command line help
+     */
+    void printUsage() {
+        std::cerr << "Usage:\n"
+            << "  bench attacks [--rounds N]\n"
+            << "  bench status [--positions N] [--threads N]\n"
+            << "  bench search [--depth N] [--hash MB]\n"
+            << "  bench smp [--depth N] [--hash MB] [--threads N]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string command = argv[1];
+    int rounds = 20;
+    int depth = 5;
+    int hashMB = 16;
+    long long positions = 1000000;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--rounds" && hasValue) {
+            rounds = std::atoi(argv[++i]);
+        }
+        else if (arg == "--positions" && hasValue) {
+            positions = std::atoll(argv[++i]);
+        }
+        else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--depth" && hasValue) {
+            depth = std::atoi(argv[++i]);
+        }
+        else if (arg == "--hash" && hasValue) {
+            hashMB = std::atoi(argv[++i]);
+        }
+        else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (rounds < 1) {
+        rounds = 1;
+    }
+    if (positions < 1) {
+        positions = 1;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    depth = std::max(1, std::min(depth, static_cast<int>(Engine::MAX_DEPTH)));
+    hashMB = std::max(1, std::min(hashMB, static_cast<int>(TranspositionTable::MAX_SIZE_MB)));
+
+    Attacks::init();
+
+    if (command == "attacks") {
+        return benchAttacks(rounds);
+    }
+    if (command == "status") {
+        return benchStatus(static_cast<std::size_t>(positions), threads);
+    }
+    if (command == "search") {
+        return benchSearch(depth, hashMB);
+    }
+    if (command == "smp") {
+        return benchSmp(depth, hashMB, std::min(threads, static_cast<int>(Engine::MAX_THREADS)));
+    }
+
+    printUsage();
+    return EXIT_FAILURE;
+}
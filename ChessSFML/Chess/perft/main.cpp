@@ -0,0 +1,178 @@
+/**
+ * @file main.cpp
+ * @brief Command line perft runner for the chess move generator
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Usage:
+ *   perft [--suite] [--threads N]
+ *   perft --depth N [--fen "<FEN>"] [--divide] [--threads N]
+ *
+ * Without --depth the built-in reference suite runs and the exit code is
+ * non-zero if any count differs from its expected value.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "Perft.h"
+
+namespace {
+    const char* startFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    /**
+     * @brief Result of one perft run
+     */
+    struct RunResult {
+        std::uint64_t nodes;  ///< Leaf nodes counted
+        double seconds;       ///< Wall clock time taken
+        bool loaded;          ///< false if the FEN was rejected
+    };
+
+    /**
+     * @brief Runs perft on a position, optionally printing each root move
+     * @param fen Position in Forsyth-Edwards Notation
+     * @param depth Number of plies
+     * @param threads Number of worker threads
+     * @param printDivide Whether to print the count below each root move
+     * @return Node count and time
+     */
+    RunResult run(const std::string& fen, int depth, int threads, bool printDivide) {
+        auto start = std::chrono::steady_clock::now();
+
+        RunResult result = { 0, 0.0, true };
+        ChessBoard board;
+        if (!board.loadFen(fen)) {
+            result.loaded = false;
+        }
+        else if (depth == 0) {
+            result.nodes = 1;
+        }
+        else {
+            for (const PerftDivideEntry& entry : Perft::divide(fen, depth, threads)) {
+                if (printDivide) {
+                    std::cout << Perft::moveToString(entry.move) << ": " << entry.nodes << '\n';
+                }
+                result.nodes += entry.nodes;
+            }
+        }
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    /**
+     * @brief Formats a node rate in nodes per second
+     * @param nodes Number of nodes
+     * @param seconds Time taken
+     * @return Nodes per second, 0 for an immeasurably short run
+     */
+    std::uint64_t nodesPerSecond(std::uint64_t nodes, double seconds) {
+        return seconds > 0.0 ? static_cast<std::uint64_t>(nodes / seconds) : 0;
+    }
+
+    /**
+     * @brief Runs every reference position and compares the counts
+     * @param threads Number of worker threads
+     * @return Process exit code, 0 if every count matched
+     */
+    int runSuite(int threads) {
+        int failures = 0;
+        std::uint64_t totalNodes = 0;
+        double totalSeconds = 0.0;
+
+        for (const PerftCase& test : Perft::referenceSuite()) {
+            RunResult result = run(test.fen, test.depth, threads, false);
+            bool passed = result.loaded && result.nodes == test.nodes;
+            if (!passed) {
+                failures++;
+            }
+            totalNodes += result.nodes;
+            totalSeconds += result.seconds;
+
+            std::cout << (passed ? "ok    " : "FAIL  ")
+                << std::left << std::setw(32) << test.name << std::right
+                << " depth " << test.depth
+                << std::setw(12) << result.nodes;
+            if (!passed) {
+                std::cout << " (expected " << test.nodes << ")";
+            }
+            std::cout << std::setw(14) << nodesPerSecond(result.nodes, result.seconds) << " nps\n";
+        }
+
+        std::cout << "\nNodes: " << totalNodes
+            << "\nTime:  " << std::fixed << std::setprecision(3) << totalSeconds << " s"
+            << "\nNPS:   " << nodesPerSecond(totalNodes, totalSeconds)
+            << "\n" << (failures == 0 ? "All positions passed" : "Some positions failed") << std::endl;
+
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /**
+     * @brief Prints the command line help
+     */
+    void printUsage() {
+        std::cerr << "Usage:\n"
+            << "  perft [--suite] [--threads N]\n"
+            << "  perft --depth N [--fen \"<FEN>\"] [--divide] [--threads N]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string fen = startFen;
+    int depth = -1;
+    bool divide = false;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--suite") {
+            depth = -1;
+        }
+        else if (arg == "--depth" && hasValue) {
+            depth = std::atoi(argv[++i]);
+        }
+        else if (arg == "--fen" && hasValue) {
+            fen = argv[++i];
+        }
+        else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--divide") {
+            divide = true;
+        }
+        else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    if (depth < 0) {
+        return runSuite(threads);
+    }
+
+    RunResult result = run(fen, depth, threads, divide);
+    if (!result.loaded) {
+        std::cerr << "Invalid FEN: " << fen << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << (divide ? "\n" : "")
+        << "Nodes: " << result.nodes
+        << "\nTime:  " << std::fixed << std::setprecision(3) << result.seconds << " s"
+        << "\nNPS:   " << nodesPerSecond(result.nodes, result.seconds) << std::endl;
+
+    return EXIT_SUCCESS;
+}
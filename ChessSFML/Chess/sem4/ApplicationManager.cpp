@@ -24,19 +24,21 @@ void ApplicationManager::initialize() {
 }
 
 void ApplicationManager::setScreen(const std::string& screenName) {
-    auto it = screens.find(screenName);
+    bool againstComputer = screenName == "computer";
+    auto it = screens.find(againstComputer ? "game" : screenName);
     if (it != screens.end()) {
         if (currentScreen) {
             currentScreen->onExit();
         }
 
-        if (screenName == "game") {
+        if (it->first == "game") {
             window.setSize(sf::Vector2u(1280, 720));
             sf::FloatRect visibleArea(0, 0, 1280, 720);
             window.setView(sf::View(visibleArea));
 
             GameScreen* gameScreen = static_cast<GameScreen*>(it->second);
             gameScreen->setPlayerTimes(whitePlayerTimeSeconds, blackPlayerTimeSeconds);
+            gameScreen->setComputerOpponent(againstComputer, computerMoveSeconds);
         }
         else if (currentScreen == screens["game"]) {
             window.setSize(sf::Vector2u(600, 600));
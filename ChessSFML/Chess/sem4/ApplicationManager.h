@@ -52,6 +52,9 @@ private:
     /// Time remaining for black player in seconds
     int blackPlayerTimeSeconds = 600;
 
+    /// Thinking time of the computer opponent per move in seconds
+    int computerMoveSeconds = 3;
+
 public:
     /**
      * @brief Default constructor
@@ -105,6 +108,18 @@ public:
      */
     int getBlackPlayerTime() const { return blackPlayerTimeSeconds; }
 
+    /**
+     * @brief Set the thinking time of the computer opponent
+     * @param seconds Time per move in seconds
+     */
+    void setComputerMoveTime(int seconds) { computerMoveSeconds = seconds; }
+
+    /**
+     * @brief Get the thinking time of the computer opponent
+     * @return int Time per move in seconds
+     */
+    int getComputerMoveTime() const { return computerMoveSeconds; }
+
     /**
      * @brief Set times for both players simultaneously
      * @param whiteTimeSeconds Time for white player in seconds
@@ -121,6 +136,10 @@ public:
 
     /**
      * @brief Switch to a specific screen
+     *
+     * "computer" opens the game screen with the computer playing black;
+     * "game" opens it for two players.
+     *
      * @param screenName Name of the screen to switch to
      */
     void setScreen(const std::string& screenName);
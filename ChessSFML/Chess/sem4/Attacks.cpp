@@ -0,0 +1,337 @@
+#include "Attacks.h"
+#include <mutex>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define ATTACKS_X86_64 1
+#endif
+
+#if defined(ATTACKS_X86_64) && defined(__GNUC__)
+#define ATTACKS_TARGET_BMI2 __attribute__((target("bmi2")))
+#define ATTACKS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ATTACKS_TARGET_BMI2
+#define ATTACKS_TARGET_AVX2
+#endif
+
+// Magic multipliers for the a8 = 0 square numbering, found offline by a
+// random search; every one maps its square's blocker sets without collisions
+static const Bitboard rookMagicNumbers[64] = {
+    0x1080004008801020ULL, 0x0840092002c03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+    0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+    0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+    0x000a001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+    0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021d00100ULL,
+    0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000a0001768104ULL,
+    0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+    0x0442000a00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040a00128541ULL,
+    0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+    0x0400802402800800ULL, 0xc100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+    0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000a0020ULL,
+    0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+    0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040a00300ULL, 0x0801100280080480ULL,
+    0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+    0x0000209300488001ULL, 0x04c1002414824001ULL, 0x020020000b001041ULL, 0x7000100004200901ULL,
+    0x8002002004100802ULL, 0x30010002084c0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL
+};
+
+static const Bitboard bishopMagicNumbers[64] = {
+    0xa010041108003100ULL, 0x006082020a002900ULL, 0x6810010619200000ULL, 0x08281a0520000408ULL,
+    0x0001104001000400ULL, 0x0018901008048400ULL, 0x00040a0210245280ULL, 0x000200210808a402ULL,
+    0x9140048410821200ULL, 0x0800091010820041ULL, 0x20504804832202c0ULL, 0x0100091401081000ULL,
+    0x8021011140000012ULL, 0x0810020804450400ULL, 0x208b0542109008a2ULL, 0x0080084a08040204ULL,
+    0x0040e2a80811244cULL, 0x2505022008008108ULL, 0x0430220100420040ULL, 0x010a040420220040ULL,
+    0x1105000290400000ULL, 0x0093001200822120ULL, 0x4000a62048043004ULL, 0x280120048a015004ULL,
+    0x006090002a020814ULL, 0x44042000240800d0ULL, 0x01102800040a4400ULL, 0x1004080080220040ULL,
+    0x0001001011004024ULL, 0x0010044000805040ULL, 0x0914041200820100ULL, 0x0004821012821480ULL,
+    0x0024040500c05021ULL, 0x0088611002080200ULL, 0x0116080a00040020ULL, 0x4000020080080080ULL,
+    0x2450450140840040ULL, 0x0000880201484100ULL, 0x0222020404020092ULL, 0x8081110600002e00ULL,
+    0x2842101105000801ULL, 0x1100809008001025ULL, 0x00020202221c0400ULL, 0x0422014022009020ULL,
+    0x0210046102100c00ULL, 0xc004008082029102ULL, 0x00aa461801101200ULL, 0x0404080080201108ULL,
+    0x020542108c205002ULL, 0x0410544804100100ULL, 0x0040910841100000ULL, 0x0400200042021100ULL,
+    0x00004204850400c0ULL, 0x0200100410a42102ULL, 0x1040020801210102ULL, 0x0805040410420000ULL,
+    0x2884804130100200ULL, 0x800c262201242000ULL, 0x1058000194108800ULL, 0x0014221054420204ULL,
+    0x0104000012a02200ULL, 0x0200881003300100ULL, 0x0140400202840100ULL, 0x0402020801010201ULL
+};
+
+static Bitboard rookTable[102400];  // sum of 2^bits over all squares
+static Bitboard bishopTable[5248];
+
+SliderMagic Attacks::rookMagics[64];
+SliderMagic Attacks::bishopMagics[64];
+bool Attacks::pextEnabled = false;
+FillKernel Attacks::fillKernel = FillKernel::SCALAR;
+bool Attacks::avx2Supported = false;
+
+// Kogge-Stone directions, laid out as in Attacks::slidingAttacksScalar()
+static const int fillShifts[4] = { 1, 8, 9, 7 };
+static const Bitboard upWraps[4] = { ~FILE_A_BB, ~Bitboard(0), ~FILE_A_BB, ~FILE_H_BB };
+static const Bitboard downWraps[4] = { ~FILE_H_BB, ~Bitboard(0), ~FILE_H_BB, ~FILE_A_BB };
+
+/**
+ * @brief Checks whether the running CPU supports BMI2
+ * @return bool True if PEXT can be used
+ */
+static bool cpuHasBmi2() {
+#if defined(ATTACKS_X86_64) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 8)) != 0;
+#elif defined(ATTACKS_X86_64) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") != 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Checks whether the running CPU and operating system support AVX2
+ * @return bool True if 256-bit integer instructions can be used
+ */
+static bool cpuHasAvx2() {
+#if defined(ATTACKS_X86_64) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // The OS must save the YMM registers on context switches
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#elif defined(ATTACKS_X86_64) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Returns the highest square in a non-empty bitboard
+ * @param b Bitboard (must not be empty)
+ * @return Square index of the most significant set bit
+ */
+static int msb(Bitboard b) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, b);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(b);
+#endif
+}
+
+ATTACKS_TARGET_BMI2
+unsigned Attacks::pextIndex(Bitboard occupancy, Bitboard mask) {
+#ifdef ATTACKS_X86_64
+    return static_cast<unsigned>(_pext_u64(occupancy, mask));
+#else
+    // Portable equivalent; never reached because pextEnabled stays false
+    unsigned index = 0;
+    for (unsigned bit = 0; mask; mask &= mask - 1, bit++) {
+        if (occupancy & mask & (0 - mask)) {
+            index |= 1u << bit;
+        }
+    }
+    return index;
+#endif
+}
+
+#ifdef ATTACKS_X86_64
+/**
+ * @brief Shifts the two lanes of a register left by different amounts
+ * @param v Lanes to shift
+ * @param low Shift count for lane 0
+ * @param high Shift count for lane 1
+ * @return __m128i Shifted lanes
+ */
+static inline __m128i shiftLeftLanes(__m128i v, __m128i low, __m128i high) {
+    // SSE2 has no per-lane shift counts: shift both ways and keep one lane of each
+    return _mm_castpd_si128(_mm_move_sd(_mm_castsi128_pd(_mm_sll_epi64(v, high)), _mm_castsi128_pd(_mm_sll_epi64(v, low))));
+}
+
+/**
+ * @brief Shifts the two lanes of a register right by different amounts
+ * @param v Lanes to shift
+ * @param low Shift count for lane 0
+ * @param high Shift count for lane 1
+ * @return __m128i Shifted lanes
+ */
+static inline __m128i shiftRightLanes(__m128i v, __m128i low, __m128i high) {
+    return _mm_castpd_si128(_mm_move_sd(_mm_castsi128_pd(_mm_srl_epi64(v, high)), _mm_castsi128_pd(_mm_srl_epi64(v, low))));
+}
+#endif
+
+Bitboard Attacks::fillSse2(Bitboard orthogonal, Bitboard diagonal, Bitboard occupancy) {
+#ifdef ATTACKS_X86_64
+    const __m128i empty = _mm_set1_epi64x(static_cast<long long>(~occupancy));
+    __m128i attacks = _mm_setzero_si128();
+
+    // Directions 0-1 (rook) and 2-3 (bishop) share a register each
+    for (int pair = 0; pair < 4; pair += 2) {
+        Bitboard generator = pair == 0 ? orthogonal : diagonal;
+        __m128i counts[3][2];
+        for (int step = 0; step < 3; step++) {
+            counts[step][0] = _mm_cvtsi32_si128(fillShifts[pair] << step);
+            counts[step][1] = _mm_cvtsi32_si128(fillShifts[pair + 1] << step);
+        }
+
+        __m128i wrap = _mm_set_epi64x(static_cast<long long>(upWraps[pair + 1]), static_cast<long long>(upWraps[pair]));
+        __m128i gen = _mm_set1_epi64x(static_cast<long long>(generator));
+        __m128i pro = _mm_and_si128(empty, wrap);
+        for (int step = 0; step < 3; step++) {
+            gen = _mm_or_si128(gen, _mm_and_si128(pro, shiftLeftLanes(gen, counts[step][0], counts[step][1])));
+            pro = _mm_and_si128(pro, shiftLeftLanes(pro, counts[step][0], counts[step][1]));
+        }
+        attacks = _mm_or_si128(attacks, _mm_and_si128(shiftLeftLanes(gen, counts[0][0], counts[0][1]), wrap));
+
+        wrap = _mm_set_epi64x(static_cast<long long>(downWraps[pair + 1]), static_cast<long long>(downWraps[pair]));
+        gen = _mm_set1_epi64x(static_cast<long long>(generator));
+        pro = _mm_and_si128(empty, wrap);
+        for (int step = 0; step < 3; step++) {
+            gen = _mm_or_si128(gen, _mm_and_si128(pro, shiftRightLanes(gen, counts[step][0], counts[step][1])));
+            pro = _mm_and_si128(pro, shiftRightLanes(pro, counts[step][0], counts[step][1]));
+        }
+        attacks = _mm_or_si128(attacks, _mm_and_si128(shiftRightLanes(gen, counts[0][0], counts[0][1]), wrap));
+    }
+
+    attacks = _mm_or_si128(attacks, _mm_unpackhi_epi64(attacks, attacks));
+    return static_cast<Bitboard>(_mm_cvtsi128_si64(attacks));
+#else
+    return slidingAttacksScalar(orthogonal, diagonal, occupancy);
+#endif
+}
+
+ATTACKS_TARGET_AVX2
+Bitboard Attacks::fillAvx2(Bitboard orthogonal, Bitboard diagonal, Bitboard occupancy) {
+#ifdef ATTACKS_X86_64
+    const __m256i shift1 = _mm256_setr_epi64x(fillShifts[0], fillShifts[1], fillShifts[2], fillShifts[3]);
+    const __m256i shift2 = _mm256_add_epi64(shift1, shift1);
+    const __m256i shift4 = _mm256_add_epi64(shift2, shift2);
+    const __m256i generators = _mm256_setr_epi64x(static_cast<long long>(orthogonal), static_cast<long long>(orthogonal),
+        static_cast<long long>(diagonal), static_cast<long long>(diagonal));
+    const __m256i empty = _mm256_set1_epi64x(static_cast<long long>(~occupancy));
+    const __m256i upWrap = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(upWraps));
+    const __m256i downWrap = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(downWraps));
+
+    __m256i gen = generators;
+    __m256i pro = _mm256_and_si256(empty, upWrap);
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift1)));
+    pro = _mm256_and_si256(pro, _mm256_sllv_epi64(pro, shift1));
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift2)));
+    pro = _mm256_and_si256(pro, _mm256_sllv_epi64(pro, shift2));
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift4)));
+    __m256i attacks = _mm256_and_si256(_mm256_sllv_epi64(gen, shift1), upWrap);
+
+    gen = generators;
+    pro = _mm256_and_si256(empty, downWrap);
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift1)));
+    pro = _mm256_and_si256(pro, _mm256_srlv_epi64(pro, shift1));
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift2)));
+    pro = _mm256_and_si256(pro, _mm256_srlv_epi64(pro, shift2));
+    gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift4)));
+    attacks = _mm256_or_si256(attacks, _mm256_and_si256(_mm256_srlv_epi64(gen, shift1), downWrap));
+
+    // Fold the four directions into one bitboard
+    __m128i folded = _mm_or_si128(_mm256_castsi256_si128(attacks), _mm256_extracti128_si256(attacks, 1));
+    folded = _mm_or_si128(folded, _mm_unpackhi_epi64(folded, folded));
+    return static_cast<Bitboard>(_mm_cvtsi128_si64(folded));
+#else
+    return slidingAttacksScalar(orthogonal, diagonal, occupancy);
+#endif
+}
+
+bool Attacks::isSupported(FillKernel kernel) {
+    switch (kernel) {
+    case FillKernel::AVX2: return avx2Supported;
+#ifdef ATTACKS_X86_64
+    case FillKernel::SSE2: return true;  // part of every x86-64 CPU
+#endif
+    case FillKernel::SCALAR: return true;
+    default: return false;
+    }
+}
+
+bool Attacks::setFillKernel(FillKernel kernel) {
+    if (!isSupported(kernel)) {
+        return false;
+    }
+    fillKernel = kernel;
+    return true;
+}
+
+void Attacks::buildTables(SliderMagic* magics, Bitboard* table, bool rook) {
+    static const Direction rookDirections[4] = { NORTH, EAST, SOUTH, WEST };
+    static const Direction bishopDirections[4] = { NORTH_WEST, NORTH_EAST, SOUTH_WEST, SOUTH_EAST };
+    const Direction* directions = rook ? rookDirections : bishopDirections;
+    const Bitboard* magicNumbers = rook ? rookMagicNumbers : bishopMagicNumbers;
+
+    // A ray pointing towards a8 runs to lower square numbers, so its
+    // nearest blocker is the highest set bit; the rays leaving a8 that way
+    // (and h1 the other way) are empty, which lets those corners act as
+    // sentinels when a ray has no blocker
+    const Bitboard* rays[4];
+    bool towardsLower[4];
+    for (int d = 0; d < 4; d++) {
+        rays[d] = tables.rays[directions[d]];
+        towardsLower[d] = directions[d] == NORTH || directions[d] == WEST ||
+            directions[d] == NORTH_WEST || directions[d] == NORTH_EAST;
+    }
+
+    Bitboard* next = table;
+    for (int square = 0; square < 64; square++) {
+        // A ray's last square never blocks anything further along it
+        Bitboard mask = 0;
+        for (int d = 0; d < 4; d++) {
+            Bitboard ray = rays[d][square];
+            if (ray) {
+                int last = towardsLower[d] ? lsb(ray) : msb(ray);
+                mask |= ray & ~squareBB(last);
+            }
+        }
+
+        SliderMagic& m = magics[square];
+        m.mask = mask;
+        m.magic = magicNumbers[square];
+        m.shift = 64 - popCount(mask);
+        m.attacks = next;
+        next += Bitboard(1) << popCount(mask);
+
+        // Enumerate every subset of the mask (Carry-Rippler); each ray is
+        // cut at its first blocker by removing the ray continuing past it
+        Bitboard blockers = 0;
+        unsigned index = 0;
+        do {
+            Bitboard attacks = 0;
+            for (int d = 0; d < 4; d++) {
+                Bitboard hit = rays[d][square] & blockers;
+                int first = towardsLower[d] ? msb(hit | squareBB(0)) : lsb(hit | squareBB(63));
+                attacks |= rays[d][square] ^ rays[d][first];
+            }
+
+            if (!pextEnabled) {
+                index = static_cast<unsigned>((blockers * m.magic) >> m.shift);
+            }
+            m.attacks[index++] = attacks;  // subsets come out in PEXT index order
+            blockers = (blockers - mask) & mask;
+        } while (blockers);
+    }
+}
+
+void Attacks::init() {
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        pextEnabled = cpuHasBmi2();
+        avx2Supported = cpuHasAvx2();
+        fillKernel = avx2Supported ? FillKernel::AVX2 : FillKernel::SCALAR;
+        buildTables(rookMagics, rookTable, true);
+        buildTables(bishopMagics, bishopTable, false);
+    });
+}
@@ -0,0 +1,408 @@
+/**
+ * @file Attacks.h
+ * @brief Precomputed attack and ray tables
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Knight, king and pawn attacks, rays, lines and the squares between two
+ * squares do not depend on the occupancy; they are computed by the
+ * compiler and stored in the binary as constants.
+ *
+ * Rook and bishop attacks are looked up in "fancy" magic bitboard tables:
+ * the blockers relevant to a square are multiplied by a per-square magic
+ * constant and the top bits of the product index that square's slice of
+ * the table. On CPUs with BMI2 the index is produced by a single PEXT
+ * instruction instead; the choice is made once at startup by Attacks::init.
+ *
+ * Whole-board attack maps of many sliders at once use Kogge-Stone occluded
+ * fills, which shift every slider of a set along a direction together.
+ * The eight directions are independent, so the AVX2 kernel runs four of
+ * them per instruction; CPUs without AVX2 use plain 64-bit code.
+ */
+
+#pragma once
+#include "Bitboard.h"
+#include "PieceCode.h"
+
+/**
+ * @brief Ray directions, as used by Attacks::ray()
+ *
+ * North points towards row 0 (black's back rank). The first four are the
+ * rook directions, the last four the bishop directions.
+ */
+enum Direction {
+    NORTH, EAST, SOUTH, WEST,
+    NORTH_WEST, NORTH_EAST, SOUTH_WEST, SOUTH_EAST
+};
+
+/**
+ * @struct LookupTables
+ * @brief Attack and geometry tables that do not depend on the occupancy
+ *
+ * Filled entirely by the constexpr constructor, so Attacks::tables is
+ * a compile-time constant with no initialization at runtime.
+ */
+struct LookupTables {
+    Bitboard knight[64];          ///< Knight attacks per square
+    Bitboard king[64];            ///< King attacks per square
+    Bitboard pawn[2][64];         ///< Pawn captures per color (0 = white) and square
+    Bitboard rays[8][64];         ///< Squares from a square to the board edge per Direction
+    Bitboard between[64][64];     ///< Squares strictly between two aligned squares, 0 if not aligned
+    Bitboard line[64][64];        ///< Whole rank, file or diagonal through two aligned squares, 0 if not aligned
+
+    constexpr LookupTables() : knight(), king(), pawn(), rays(), between(), line() {
+        const int rowSteps[8] = { -1, 0, 1, 0, -1, -1, 1, 1 };
+        const int colSteps[8] = { 0, 1, 0, -1, -1, 1, -1, 1 };
+        const int knightSteps[8][2] = {
+            {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+            {1, -2}, {1, 2}, {2, -1}, {2, 1}
+        };
+
+        for (int square = 0; square < 64; square++) {
+            int row = rowOf(square);
+            int col = colOf(square);
+
+            for (int i = 0; i < 8; i++) {
+                knight[square] |= stepBB(row + knightSteps[i][0], col + knightSteps[i][1]);
+                king[square] |= stepBB(row + rowSteps[i], col + colSteps[i]);
+
+                for (int r = row + rowSteps[i], c = col + colSteps[i]; onBoard(r, c); r += rowSteps[i], c += colSteps[i]) {
+                    rays[i][square] |= squareBB(makeSquare(r, c));
+                }
+            }
+
+            // White pawns capture towards row 0
+            pawn[0][square] = stepBB(row - 1, col - 1) | stepBB(row - 1, col + 1);
+            pawn[1][square] = stepBB(row + 1, col - 1) | stepBB(row + 1, col + 1);
+        }
+
+        for (int from = 0; from < 64; from++) {
+            for (int d = 0; d < 8; d++) {
+                int opposite = d < 4 ? d ^ 2 : 11 - d;
+                Bitboard wholeLine = rays[d][from] | rays[opposite][from] | squareBB(from);
+
+                for (int r = rowOf(from) + rowSteps[d], c = colOf(from) + colSteps[d]; onBoard(r, c); r += rowSteps[d], c += colSteps[d]) {
+                    int to = makeSquare(r, c);
+                    between[from][to] = rays[d][from] & rays[opposite][to];
+                    line[from][to] = wholeLine;
+                }
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Checks whether coordinates lie on the board
+     * @param row Row number
+     * @param col Column number
+     * @return true for 0-7 in both coordinates
+     */
+    static constexpr bool onBoard(int row, int col) { return row >= 0 && row < 8 && col >= 0 && col < 8; }
+
+    /**
+     * @brief Returns the square at the given coordinates as a bitboard
+     * @param row Row number, may be off the board
+     * @param col Column number, may be off the board
+     * @return Single-bit bitboard, or 0 if the coordinates are off the board
+     */
+    static constexpr Bitboard stepBB(int row, int col) { return onBoard(row, col) ? squareBB(makeSquare(row, col)) : 0; }
+};
+
+/**
+ * @brief Implementations of Attacks::slidingAttacks()
+ */
+enum class FillKernel {
+    SCALAR,  ///< One direction at a time in 64-bit registers
+    SSE2,    ///< Two directions per 128-bit register; lacking per-lane shifts it trails SCALAR, kept for comparison
+    AVX2     ///< Four directions per 256-bit register
+};
+
+/**
+ * @struct SliderMagic
+ * @brief Lookup parameters for one square of a sliding piece
+ */
+struct SliderMagic {
+    Bitboard mask;      ///< Squares whose occupancy affects the attacks (board edges excluded)
+    Bitboard magic;     ///< Multiplier mapping blocker sets to distinct table indices
+    Bitboard* attacks;  ///< First table entry belonging to this square
+    unsigned shift;     ///< 64 minus the number of relevant blocker squares
+};
+
+/**
+ * @class Attacks
+ * @brief Attack set lookups shared by ChessBoard and the piece classes
+ */
+class Attacks {
+private:
+    static constexpr LookupTables tables = LookupTables();  ///< Tables that do not depend on the occupancy
+    static SliderMagic rookMagics[64];                      ///< Rook lookup parameters per square
+    static SliderMagic bishopMagics[64];                    ///< Bishop lookup parameters per square
+    static bool pextEnabled;                                ///< True when the tables are indexed with PEXT
+    static FillKernel fillKernel;                           ///< Kernel used by slidingAttacks()
+    static bool avx2Supported;                              ///< True when the CPU and OS support AVX2
+
+    /**
+     * @brief Builds the tables for one piece type
+     * @param magics Lookup parameters to fill
+     * @param table Storage for every attack set of that piece type
+     * @param rook True for rook tables, false for bishop tables
+     */
+    static void buildTables(SliderMagic* magics, Bitboard* table, bool rook);
+
+    /**
+     * @brief Computes a table index with the BMI2 PEXT instruction
+     * @param occupancy Occupied squares
+     * @param mask Relevant blocker squares
+     * @return Index of the attack set within the square's slice
+     */
+    static unsigned pextIndex(Bitboard occupancy, Bitboard mask);
+
+    /**
+     * @brief Kogge-Stone fill with SSE2, two directions per register
+     * @param orthogonal Rooks and queens
+     * @param diagonal Bishops and queens
+     * @param occupancy Occupied squares
+     * @return Squares attacked by any of the sliders
+     */
+    static Bitboard fillSse2(Bitboard orthogonal, Bitboard diagonal, Bitboard occupancy);
+
+    /**
+     * @brief Kogge-Stone fill with AVX2, four directions per register
+     * @param orthogonal Rooks and queens
+     * @param diagonal Bishops and queens
+     * @param occupancy Occupied squares
+     * @return Squares attacked by any of the sliders
+     */
+    static Bitboard fillAvx2(Bitboard orthogonal, Bitboard diagonal, Bitboard occupancy);
+
+public:
+    /**
+     * @brief Fills the attack tables
+     *
+     * Safe to call any number of times from any thread; only the first
+     * call does work (well under a millisecond).
+     */
+    static void init();
+
+    /**
+     * @brief Checks which indexing scheme the tables were built for
+     * @return bool True if PEXT is used, false for multiply-shift magics
+     */
+    static bool usesPext() { return pextEnabled; }
+
+    /**
+     * @brief Returns the kernel slidingAttacks() currently uses
+     * @return FillKernel AVX2 if supported, otherwise SCALAR, unless setFillKernel() chose another
+     */
+    static FillKernel getFillKernel() { return fillKernel; }
+
+    /**
+     * @brief Checks whether a fill kernel can run on this machine
+     * @param kernel Kernel to check
+     * @return bool True if the CPU supports it
+     */
+    static bool isSupported(FillKernel kernel);
+
+    /**
+     * @brief Selects the kernel used by slidingAttacks()
+     *
+     * Meant for benchmarks and comparisons; must not be called while
+     * another thread is computing attacks.
+     *
+     * @param kernel Kernel to use
+     * @return bool False (and no change) if the kernel is not supported
+     */
+    static bool setFillKernel(FillKernel kernel);
+
+    /**
+     * @brief Returns the squares a knight attacks
+     * @param square Square of the knight
+     * @return Bitboard Attacked squares
+     */
+    static constexpr Bitboard knight(int square) { return tables.knight[square]; }
+
+    /**
+     * @brief Returns the squares a king attacks
+     * @param square Square of the king
+     * @return Bitboard Attacked squares, castling not included
+     */
+    static constexpr Bitboard king(int square) { return tables.king[square]; }
+
+    /**
+     * @brief Returns the squares a pawn attacks
+     * @param color Color of the pawn
+     * @param square Square of the pawn
+     * @return Bitboard The one or two squares diagonally ahead of it
+     */
+    static constexpr Bitboard pawn(PieceColor color, int square) {
+        return tables.pawn[color == PieceColor::BLACK ? 1 : 0][square];
+    }
+
+    /**
+     * @brief Returns the squares from a square to the edge of the board
+     * @param direction Direction of the ray
+     * @param square Starting square (not part of the ray)
+     * @return Bitboard Squares on the ray
+     */
+    static constexpr Bitboard ray(Direction direction, int square) { return tables.rays[direction][square]; }
+
+    /**
+     * @brief Returns the squares strictly between two squares
+     * @param from First square
+     * @param to Second square
+     * @return Bitboard Squares between them, 0 if they do not share a rank, file or diagonal
+     */
+    static constexpr Bitboard between(int from, int to) { return tables.between[from][to]; }
+
+    /**
+     * @brief Returns the whole rank, file or diagonal through two squares
+     * @param from First square
+     * @param to Second square
+     * @return Bitboard Squares of the line, edge to edge, 0 if the squares are not aligned
+     */
+    static constexpr Bitboard line(int from, int to) { return tables.line[from][to]; }
+
+    /**
+     * @brief Returns the squares a rook attacks
+     * @param square Square of the rook
+     * @param occupancy Occupied squares
+     * @return Bitboard Attacked squares, including the first blocker in each direction
+     */
+    static Bitboard rook(int square, Bitboard occupancy) {
+        const SliderMagic& m = rookMagics[square];
+        if (pextEnabled) {
+            return m.attacks[pextIndex(occupancy, m.mask)];
+        }
+        return m.attacks[((occupancy & m.mask) * m.magic) >> m.shift];
+    }
+
+    /**
+     * @brief Returns the squares a bishop attacks
+     * @param square Square of the bishop
+     * @param occupancy Occupied squares
+     * @return Bitboard Attacked squares, including the first blocker in each direction
+     */
+    static Bitboard bishop(int square, Bitboard occupancy) {
+        const SliderMagic& m = bishopMagics[square];
+        if (pextEnabled) {
+            return m.attacks[pextIndex(occupancy, m.mask)];
+        }
+        return m.attacks[((occupancy & m.mask) * m.magic) >> m.shift];
+    }
+
+    /**
+     * @brief Returns the squares a queen attacks
+     * @param square Square of the queen
+     * @param occupancy Occupied squares
+     * @return Bitboard Union of the rook and bishop attacks
+     */
+    static Bitboard queen(int square, Bitboard occupancy) {
+        return rook(square, occupancy) | bishop(square, occupancy);
+    }
+
+    /**
+     * @brief Returns every square attacked by a set of sliding pieces
+     *
+     * Computes the union for all pieces at once rather than square by
+     * square, which suits attack maps of a whole side.
+     *
+     * @param orthogonal Pieces moving like a rook (rooks and queens)
+     * @param diagonal Pieces moving like a bishop (bishops and queens)
+     * @param occupancy Occupied squares
+     * @return Bitboard Attacked squares, including the first blocker in each direction
+     */
+    static Bitboard slidingAttacks(Bitboard orthogonal, Bitboard diagonal, Bitboard occupancy) {
+        switch (fillKernel) {
+        case FillKernel::AVX2: return fillAvx2(orthogonal, diagonal, occupancy);
+        case FillKernel::SSE2: return fillSse2(orthogonal, diagonal, occupancy);
+        default:               return slidingAttacksScalar(orthogonal, diagonal, occupancy);
+        }
+    }
+
+    /**
+     * @brief Kogge-Stone fill in 64-bit registers, one direction at a time
+     *
+     * The SCALAR kernel of slidingAttacks(). It is inline and branch-free,
+     * so a loop applying it to many positions can be vectorized by the
+     * compiler across positions.
+     *
+     * @param orthogonal Pieces moving like a rook (rooks and queens)
+     * @param diagonal Pieces moving like a bishop (bishops and queens)
+     * @param occupancy Occupied squares
+     * @return Bitboard Attacked squares, including the first blocker in each direction
+     */
+    static constexpr Bitboard slidingAttacksScalar(Bitboard orthogonal, Bitboard diagonal, Bitboard occupancy) {
+        // The same four shift amounts serve the fills towards higher squares
+        // (east, south, south-east, south-west) and towards lower squares
+        // (west, north, north-west, north-east); the wrap masks drop squares
+        // a shift carries across the board edge
+        const int shifts[4] = { 1, 8, 9, 7 };
+        const Bitboard upWraps[4] = { ~FILE_A_BB, ~Bitboard(0), ~FILE_A_BB, ~FILE_H_BB };
+        const Bitboard downWraps[4] = { ~FILE_H_BB, ~Bitboard(0), ~FILE_H_BB, ~FILE_A_BB };
+        const Bitboard generators[4] = { orthogonal, orthogonal, diagonal, diagonal };
+
+        Bitboard attacks = 0;
+        for (int d = 0; d < 4; d++) {
+            int shift = shifts[d];
+
+            Bitboard gen = generators[d];
+            Bitboard empty = ~occupancy & upWraps[d];
+            gen |= empty & (gen << shift);
+            empty &= empty << shift;
+            gen |= empty & (gen << 2 * shift);
+            empty &= empty << 2 * shift;
+            gen |= empty & (gen << 4 * shift);
+            attacks |= (gen << shift) & upWraps[d];
+
+            gen = generators[d];
+            empty = ~occupancy & downWraps[d];
+            gen |= empty & (gen >> shift);
+            empty &= empty >> shift;
+            gen |= empty & (gen >> 2 * shift);
+            empty &= empty >> 2 * shift;
+            gen |= empty & (gen >> 4 * shift);
+            attacks |= (gen >> shift) & downWraps[d];
+        }
+        return attacks;
+    }
+
+    /**
+     * @brief Returns every square attacked by a set of knights
+     * @param knights Squares of the knights
+     * @return Bitboard Attacked squares
+     */
+    static constexpr Bitboard knightSet(Bitboard knights) {
+        const Bitboard notA = ~FILE_A_BB;
+        const Bitboard notH = ~FILE_H_BB;
+        const Bitboard notAB = ~(FILE_A_BB | (FILE_A_BB << 1));
+        const Bitboard notGH = ~(FILE_H_BB | (FILE_H_BB >> 1));
+        return ((knights << 17) & notA) | ((knights << 15) & notH) |
+            ((knights >> 15) & notA) | ((knights >> 17) & notH) |
+            ((knights << 10) & notAB) | ((knights << 6) & notGH) |
+            ((knights >> 6) & notAB) | ((knights >> 10) & notGH);
+    }
+
+    /**
+     * @brief Returns every square attacked by a set of kings
+     * @param kings Squares of the kings
+     * @return Bitboard Attacked squares
+     */
+    static constexpr Bitboard kingSet(Bitboard kings) {
+        Bitboard sideways = ((kings << 1) & ~FILE_A_BB) | ((kings >> 1) & ~FILE_H_BB);
+        Bitboard row = kings | sideways;
+        return sideways | (row << 8) | (row >> 8);
+    }
+
+    /**
+     * @brief Returns every square attacked by a set of pawns
+     * @param color Color of the pawns
+     * @param pawns Squares of the pawns
+     * @return Bitboard Squares diagonally ahead of any of them
+     */
+    static constexpr Bitboard pawnSet(PieceColor color, Bitboard pawns) {
+        // White pawns capture towards row 0, i.e. to lower square numbers
+        return color == PieceColor::WHITE
+            ? ((pawns >> 9) & ~FILE_H_BB) | ((pawns >> 7) & ~FILE_A_BB)
+            : ((pawns << 9) & ~FILE_A_BB) | ((pawns << 7) & ~FILE_H_BB);
+    }
+};
@@ -6,8 +6,6 @@
  */
 
 #pragma once
-#include <vector>
-#include <SFML/System/Vector2.hpp>
 #include "Piece.h"
 
 class ChessBoard;
@@ -26,16 +24,4 @@ public:
      * @param color The color of the bishop (WHITE or BLACK)
      */
     Bishop(PieceColor color);
-
-    /**
-     * @brief Gets all possible moves for this bishop
-     * @param row Current row position of the bishop
-     * @param col Current column position of the bishop
-     * @param board Reference to the chess board
-     * @return Vector of possible destination coordinates
-     *
-     * Calculates all valid diagonal moves for the bishop from the current position,
-     * taking into account the board boundaries and other pieces.
-     */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const override;
 };
\ No newline at end of file
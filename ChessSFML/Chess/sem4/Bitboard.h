@@ -0,0 +1,105 @@
+/**
+ * @file Bitboard.h
+ * @brief 64-bit square sets and the square helpers used by the board core
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Squares are numbered row * 8 + col, which matches the (row, col)
+ * coordinates used by ChessBoard and BoardView: square 0 is a8 (top left
+ * from white's point of view) and square 63 is h1.
+ */
+
+#pragma once
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Set of squares, one bit per square
+ */
+using Bitboard = std::uint64_t;
+
+/**
+ * @brief Squares of column 0 (the a-file)
+ */
+constexpr Bitboard FILE_A_BB = 0x0101010101010101ULL;
+
+/**
+ * @brief Squares of column 7 (the h-file)
+ */
+constexpr Bitboard FILE_H_BB = FILE_A_BB << 7;
+
+/**
+ * @brief Light squares (a8, the square 0, is light)
+ */
+constexpr Bitboard LIGHT_SQUARES_BB = 0xAA55AA55AA55AA55ULL;
+
+/**
+ * @brief Converts board coordinates to a square index
+ * @param row Row number (0-7)
+ * @param col Column number (0-7)
+ * @return Square index (0-63)
+ */
+constexpr int makeSquare(int row, int col) { return row * 8 + col; }
+
+/**
+ * @brief Returns the row of a square
+ * @param square Square index (0-63)
+ * @return Row number (0-7)
+ */
+constexpr int rowOf(int square) { return square >> 3; }
+
+/**
+ * @brief Returns the column of a square
+ * @param square Square index (0-63)
+ * @return Column number (0-7)
+ */
+constexpr int colOf(int square) { return square & 7; }
+
+/**
+ * @brief Returns a bitboard containing only the given square
+ * @param square Square index (0-63)
+ * @return Single-bit bitboard
+ */
+constexpr Bitboard squareBB(int square) { return Bitboard(1) << square; }
+
+/**
+ * @brief Counts the squares in a bitboard
+ * @param b Bitboard to count
+ * @return Number of set bits
+ */
+inline int popCount(Bitboard b) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(b));
+#else
+    return __builtin_popcountll(b);
+#endif
+}
+
+/**
+ * @brief Returns the lowest square in a non-empty bitboard
+ * @param b Bitboard (must not be empty)
+ * @return Square index of the least significant set bit
+ */
+inline int lsb(Bitboard b) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, b);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(b);
+#endif
+}
+
+/**
+ * @brief Removes and returns the lowest square of a non-empty bitboard
+ * @param b Bitboard to modify (must not be empty)
+ * @return Square index that was removed
+ */
+inline int popLsb(Bitboard& b) {
+    int square = lsb(b);
+    b &= b - 1;
+    return square;
+}
@@ -2,7 +2,7 @@
 
 BoardView::BoardView(sf::RenderWindow& window, const ChessBoard& board)
     : window(&window), board(board), squareSize(75), boardPosition(0, 0),
-    possibleMoves() {
+    possibleMoves(), hangingPieces(0) {
 
     if (!boardTexture.loadFromFile("resources/images/board.png")) {
     }
@@ -51,6 +51,11 @@ BoardView::BoardView(sf::RenderWindow& window, const ChessBoard& board)
 
     possibleMoveHighlight.setSize(sf::Vector2f(squareSize, squareSize));
     possibleMoveHighlight.setFillColor(sf::Color(0, 255, 0, 128));
+
+    hangingPieceHighlight.setSize(sf::Vector2f(squareSize - 6, squareSize - 6));
+    hangingPieceHighlight.setFillColor(sf::Color::Transparent);
+    hangingPieceHighlight.setOutlineColor(sf::Color(220, 40, 40, 200));
+    hangingPieceHighlight.setOutlineThickness(3);
 }
 
 void BoardView::render() {
@@ -61,49 +66,37 @@ void BoardView::render() {
         window->draw(possibleMoveHighlight);
     }
 
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const Piece* piece = board.getPieceAt(row, col);
-            if (piece && !piece->isEmpty()) {
-                int pieceValue = piece->toInt();
-                sf::Sprite pieceSprite;
-
-                int textureIndex = -1;
-                if (pieceValue > 0) {
-                    switch (pieceValue) {
-                    case 4: textureIndex = 0; break;
-                    case 5: textureIndex = 1; break;
-                    case 1: textureIndex = 2; break;
-                    case 3: textureIndex = 3; break;
-                    case 2: textureIndex = 4; break;
-                    case 6: textureIndex = 5; break;
-                    }
-                }
-                else if (pieceValue < 0) {
-                    switch (pieceValue) {
-                    case -4: textureIndex = 6; break;
-                    case -5: textureIndex = 7; break;
-                    case -1: textureIndex = 8; break;
-                    case -3: textureIndex = 9; break;
-                    case -2: textureIndex = 10; break;
-                    case -6: textureIndex = 11; break;
-                    }
-                }
-
-                if (textureIndex >= 0) {
-                    pieceSprite.setTexture(piecesTextures[textureIndex]);
-                    pieceSprite.setScale(pieceScales[textureIndex], pieceScales[textureIndex]);
-
-                    sf::FloatRect bounds = pieceSprite.getLocalBounds();
-                    sf::Vector2f fieldPos = getScreenPosition(row, col);
-                    pieceSprite.setPosition(
-                        fieldPos.x + (squareSize - bounds.width * pieceScales[textureIndex]) / 2.0f,
-                        fieldPos.y + (squareSize - bounds.height * pieceScales[textureIndex]) / 2.0f
-                    );
-
-                    window->draw(pieceSprite);
-                }
-            }
+    Bitboard hanging = hangingPieces;
+    while (hanging) {
+        int square = popLsb(hanging);
+        sf::Vector2f fieldPos = getScreenPosition(rowOf(square), colOf(square));
+        hangingPieceHighlight.setPosition(fieldPos.x + 3, fieldPos.y + 3);
+        window->draw(hangingPieceHighlight);
+    }
+
+    // Texture index for each piece code (see PieceCode.h), -1 for empty squares
+    static const int textureIndexByCode[16] = {
+        -1, 2, 4, 3, 0, 1, 5, -1,   // white rook, knight, bishop, king, queen, pawn
+        -1, 8, 10, 9, 6, 7, 11, -1  // black
+    };
+
+    Bitboard occupied = board.getOccupied();
+    while (occupied) {
+        int square = popLsb(occupied);
+        int textureIndex = textureIndexByCode[board.getPieceCode(rowOf(square), colOf(square))];
+        if (textureIndex >= 0) {
+            sf::Sprite pieceSprite;
+            pieceSprite.setTexture(piecesTextures[textureIndex]);
+            pieceSprite.setScale(pieceScales[textureIndex], pieceScales[textureIndex]);
+
+            sf::FloatRect bounds = pieceSprite.getLocalBounds();
+            sf::Vector2f fieldPos = getScreenPosition(rowOf(square), colOf(square));
+            pieceSprite.setPosition(
+                fieldPos.x + (squareSize - bounds.width * pieceScales[textureIndex]) / 2.0f,
+                fieldPos.y + (squareSize - bounds.height * pieceScales[textureIndex]) / 2.0f
+            );
+
+            window->draw(pieceSprite);
         }
     }
 }
@@ -131,8 +124,19 @@ void BoardView::clearHighlights() {
     possibleMoves.clear();
 }
 
-void BoardView::setPossibleMoves(const std::vector<sf::Vector2i>& moves) {
-    possibleMoves = moves;
+void BoardView::setPossibleMoves(const MoveList& moves) {
+    possibleMoves.clear();
+    for (const Move& move : moves) {
+        // A promotion square is listed once per promotion piece; mark it once
+        if (move.isPromotion() && move.promotionType() != PieceType::QUEEN) {
+            continue;
+        }
+        possibleMoves.push_back(sf::Vector2i(rowOf(move.to()), colOf(move.to())));
+    }
+}
+
+void BoardView::setHangingPieces(Bitboard squares) {
+    hangingPieces = squares;
 }
 
 sf::Vector2f BoardView::getBoardCenter() const {
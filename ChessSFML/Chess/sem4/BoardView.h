@@ -56,11 +56,21 @@ private:
      */
     sf::RectangleShape possibleMoveHighlight;
 
+    /**
+     * @brief Outline marking a hanging piece
+     */
+    sf::RectangleShape hangingPieceHighlight;
+
     /**
      * @brief List of possible moves for the currently selected piece
      */
     std::vector<sf::Vector2i> possibleMoves;
 
+    /**
+     * @brief Squares outlined as hanging, set by setHangingPieces()
+     */
+    Bitboard hangingPieces;
+
     /**
      * @brief Reference to the chess board model
      */
@@ -118,9 +128,20 @@ public:
 
     /**
      * @brief Sets and highlights possible moves for the selected piece
-     * @param moves Vector of possible move positions
+     * @param moves Moves of the selected piece; their target squares are highlighted
+     */
+    void setPossibleMoves(const MoveList& moves);
+
+    /**
+     * @brief Sets the pieces outlined as hanging
+     *
+     * Finding hanging pieces takes a static exchange evaluation per
+     * piece, so the caller works them out once per move rather than the
+     * view once per frame.
+     *
+     * @param squares Squares to outline, 0 for none
      */
-    void setPossibleMoves(const std::vector<sf::Vector2i>& moves);
+    void setHangingPieces(Bitboard squares);
 
     /**
      * @brief Gets the width of the board
@@ -5,525 +5,1110 @@
 #include "Bishop.h"
 #include "Queen.h"
 #include "King.h"
+#include "Attacks.h"
+#include "PieceSquare.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace {
+    /// FEN letters of the black pieces, indexed by PieceType
+    const char pieceSymbols[] = " rnbkqp";
+
+    /// Piece values used by staticExchange(), in centipawns, indexed by PieceType
+    const int exchangeValues[7] = { 0, 500, 320, 330, 0, 900, 100 };
+
+    /// Capture order of staticExchange(), least valuable first
+    const PieceType exchangeOrder[6] = {
+        PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING
+    };
+
+    /**
+     * @brief Returns the castling rights that survive a move touching a square
+     * @param square Source or target square of a move
+     * @return CastlingRight bits to keep
+     */
+    int castlingRightsKept(int square) {
+        switch (square) {
+        case 0:  return ALL_CASTLING & ~BLACK_QUEENSIDE;                    // a8
+        case 4:  return ALL_CASTLING & ~(BLACK_KINGSIDE | BLACK_QUEENSIDE); // e8
+        case 7:  return ALL_CASTLING & ~BLACK_KINGSIDE;                     // h8
+        case 56: return ALL_CASTLING & ~WHITE_QUEENSIDE;                    // a1
+        case 60: return ALL_CASTLING & ~(WHITE_KINGSIDE | WHITE_QUEENSIDE); // e1
+        case 63: return ALL_CASTLING & ~WHITE_KINGSIDE;                     // h1
+        default: return ALL_CASTLING;
+        }
+    }
+}
 
-ChessBoard::ChessBoard() : whiteKingMoved(false), blackKingMoved(false),
-whiteRook1Moved(false), whiteRook2Moved(false),
-blackRook1Moved(false), blackRook2Moved(false),
-enPassantCol(-1), enPassantRow(-1) {
+ChessBoard::ChessBoard() : position(), initialPly(0), stateVersion(0), cachedInCheck(false), cachedVersion(0) {
+    Attacks::init();
+    Zobrist::init();
+    PieceSquare::init();
     resetBoard();
 }
 
 
 void ChessBoard::resetBoard() {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            board[row][col] = nullptr;
-        }
-    }
+    clearBoard();
 
-    board[0][0] = std::make_unique<Rook>(PieceColor::BLACK);
-    board[0][1] = std::make_unique<Knight>(PieceColor::BLACK);
-    board[0][2] = std::make_unique<Bishop>(PieceColor::BLACK);
-    board[0][3] = std::make_unique<Queen>(PieceColor::BLACK);
-    board[0][4] = std::make_unique<King>(PieceColor::BLACK);
-    board[0][5] = std::make_unique<Bishop>(PieceColor::BLACK);
-    board[0][6] = std::make_unique<Knight>(PieceColor::BLACK);
-    board[0][7] = std::make_unique<Rook>(PieceColor::BLACK);
+    const PieceType backRank[8] = {
+        PieceType::ROOK, PieceType::KNIGHT, PieceType::BISHOP, PieceType::QUEEN,
+        PieceType::KING, PieceType::BISHOP, PieceType::KNIGHT, PieceType::ROOK
+    };
 
     for (int col = 0; col < 8; col++) {
-        board[1][col] = std::make_unique<Pawn>(PieceColor::BLACK);
+        putPiece(makeSquare(0, col), backRank[col], PieceColor::BLACK);
+        putPiece(makeSquare(1, col), PieceType::PAWN, PieceColor::BLACK);
+        putPiece(makeSquare(6, col), PieceType::PAWN, PieceColor::WHITE);
+        putPiece(makeSquare(7, col), backRank[col], PieceColor::WHITE);
     }
 
-    for (int col = 0; col < 8; col++) {
-        board[6][col] = std::make_unique<Pawn>(PieceColor::WHITE);
-    }
-
-    board[7][0] = std::make_unique<Rook>(PieceColor::WHITE);
-    board[7][1] = std::make_unique<Knight>(PieceColor::WHITE);
-    board[7][2] = std::make_unique<Bishop>(PieceColor::WHITE);
-    board[7][3] = std::make_unique<Queen>(PieceColor::WHITE);
-    board[7][4] = std::make_unique<King>(PieceColor::WHITE);
-    board[7][5] = std::make_unique<Bishop>(PieceColor::WHITE);
-    board[7][6] = std::make_unique<Knight>(PieceColor::WHITE);
-    board[7][7] = std::make_unique<Rook>(PieceColor::WHITE);
-
-    whiteKingMoved = false;
-    blackKingMoved = false;
-    whiteRook1Moved = false;
-    whiteRook2Moved = false;
-    blackRook1Moved = false;
-    blackRook2Moved = false;
-    enPassantCol = -1;
-    enPassantRow = -1;
+    position.castlingRights = ALL_CASTLING;
+    position.key = computeKey();
 }
 
-const Piece* ChessBoard::getPieceAt(int row, int col) const {
-    if (isValidPosition(row, col) && board[row][col]) {
-        return board[row][col].get();
+void ChessBoard::clearBoard() {
+    stateVersion++;
+    for (Bitboard& bb : position.typeBB) {
+        bb = 0;
     }
-    static EmptyPiece emptyPiece;
-    return &emptyPiece;
+    position.colorBB[0] = 0;
+    position.colorBB[1] = 0;
+    position.kingSquares[0] = -1;
+    position.kingSquares[1] = -1;
+    position.middlegameScore = 0;
+    position.endgameScore = 0;
+    position.phase = 0;
+
+    position.castlingRights = 0;
+    position.sideToMove = PieceColor::WHITE;
+    position.enPassantCol = -1;
+    position.enPassantRow = -1;
+    position.halfmoveClock = 0;
+    history.clear();
+    keyHistory.clear();
+    initialPly = 0;
+
+    position.key = computeKey();
 }
 
-Piece* ChessBoard::getPieceAt(int row, int col) {
-    if (isValidPosition(row, col) && board[row][col]) {
-        return board[row][col].get();
-    }
-    return nullptr;
+void ChessBoard::setPosition(const Position& snapshot) {
+    stateVersion++;
+    position = snapshot;
+    history.clear();
+    keyHistory.clear();
+    initialPly = position.sideToMove == PieceColor::BLACK ? 1 : 0;
 }
 
-void ChessBoard::setPieceAt(int row, int col, std::unique_ptr<Piece> piece) {
-    if (isValidPosition(row, col)) {
-        board[row][col] = std::move(piece);
-    }
+int ChessBoard::getRepetitionKeys(std::uint64_t* keys, int capacity) const {
+    int plies = static_cast<int>(keyHistory.size());
+    int count = std::min({ static_cast<int>(position.halfmoveClock), plies, capacity });
+    std::copy(keyHistory.end() - count, keyHistory.end(), keys);
+    return count;
 }
 
-bool ChessBoard::isValidPosition(int row, int col) const {
-    return row >= 0 && row < 8 && col >= 0 && col < 8;
-}
-
-bool ChessBoard::isPieceOfCurrentPlayer(int row, int col, bool isWhiteTurn) const {
-    const Piece* piece = getPieceAt(row, col);
-    return piece && !piece->isEmpty() && ((isWhiteTurn && piece->isWhite()) || (!isWhiteTurn && piece->isBlack()));
+void ChessBoard::setPosition(const Position& snapshot, const std::uint64_t* keys, int count) {
+    setPosition(snapshot);
+    keyHistory.assign(keys, keys + count);
 }
 
-std::vector<sf::Vector2i> ChessBoard::getPossibleMoves(int row, int col) const {
-    const Piece* piece = getPieceAt(row, col);
-    if (piece && !piece->isEmpty()) {
-        return piece->getPossibleMoves(row, col, *this);
-    }
-    return {};
-}
-
-bool ChessBoard::makeMove(int fromRow, int fromCol, int toRow, int toCol) {
-    if (!isValidPosition(fromRow, fromCol) || !isValidPosition(toRow, toCol)) {
+bool ChessBoard::loadFen(const std::string& fen) {
+    std::istringstream stream(fen);
+    std::string placement, side, castling = "-", enPassant = "-";
+    if (!(stream >> placement >> side)) {
+        resetBoard();
         return false;
     }
+    stream >> castling >> enPassant;
 
-    Piece* piece = getPieceAt(fromRow, fromCol);
-    if (!piece || piece->isEmpty()) {
+    int halfmoveClock = 0;
+    int fullmoveNumber = 1;
+    if (stream >> halfmoveClock) {
+        stream >> fullmoveNumber;
+    }
+    if (halfmoveClock < 0 || fullmoveNumber < 1) {
+        resetBoard();
         return false;
     }
 
-    bool isWhiteTurn = piece->isWhite();
+    clearBoard();
 
-    auto possibleMoves = getPossibleMoves(fromRow, fromCol);
-    bool moveFound = false;
-    for (const auto& move : possibleMoves) {
-        if (move.x == toRow && move.y == toCol) {
-            moveFound = true;
-            break;
+    int row = 0;
+    int col = 0;
+    for (char symbol : placement) {
+        if (symbol == '/') {
+            if (col != 8 || ++row > 7) {
+                resetBoard();
+                return false;
+            }
+            col = 0;
+        }
+        else if (symbol >= '1' && symbol <= '8') {
+            col += symbol - '0';
+        }
+        else {
+            const char* found = std::strchr(pieceSymbols, std::tolower(static_cast<unsigned char>(symbol)));
+            if (symbol == '\0' || !found || found == pieceSymbols || col > 7) {
+                resetBoard();
+                return false;
+            }
+            PieceColor color = std::isupper(static_cast<unsigned char>(symbol)) ? PieceColor::WHITE : PieceColor::BLACK;
+            putPiece(makeSquare(row, col++), static_cast<PieceType>(found - pieceSymbols), color);
+        }
+        if (col > 8) {
+            resetBoard();
+            return false;
         }
     }
-
-    if (!moveFound) {
+    if (row != 7 || col != 8 || (side != "w" && side != "b")) {
+        resetBoard();
         return false;
     }
 
-    bool isCastling = false;
-    if (piece->getType() == PieceType::KING && abs(fromCol - toCol) == 2) {
-        isCastling = true;
+    position.sideToMove = side == "w" ? PieceColor::WHITE : PieceColor::BLACK;
+
+    if (castling != "-") {
+        for (char right : castling) {
+            switch (right) {
+            case 'K': position.castlingRights |= WHITE_KINGSIDE; break;
+            case 'Q': position.castlingRights |= WHITE_QUEENSIDE; break;
+            case 'k': position.castlingRights |= BLACK_KINGSIDE; break;
+            case 'q': position.castlingRights |= BLACK_QUEENSIDE; break;
+            default:
+                resetBoard();
+                return false;
+            }
+        }
+    }
 
-        if (isKingInCheck(isWhiteTurn ? PieceColor::WHITE : PieceColor::BLACK)) {
+    if (enPassant != "-") {
+        if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' ||
+            (enPassant[1] != '3' && enPassant[1] != '6')) {
+            resetBoard();
             return false;
         }
+        position.enPassantCol = static_cast<signed char>(enPassant[0] - 'a');
+        position.enPassantRow = static_cast<signed char>('8' - enPassant[1]);
+    }
 
-        bool isKingsideCastling = (toCol > fromCol);
-        int middleCol = isKingsideCastling ? 5 : 3;
+    position.halfmoveClock = static_cast<std::uint16_t>(std::min(halfmoveClock, 10000));
+    initialPly = 2 * (std::min(fullmoveNumber, 100000) - 1) + (position.sideToMove == PieceColor::BLACK ? 1 : 0);
+    position.key = computeKey();
+    return true;
+}
 
-        if (wouldMoveExposeKing(fromRow, fromCol, fromRow, middleCol, isWhiteTurn)) {
-            return false;
+std::string ChessBoard::toFen() const {
+    std::string fen;
+    for (int row = 0; row < 8; row++) {
+        int empty = 0;
+        for (int col = 0; col < 8; col++) {
+            PieceCode code = position.pieceOn(makeSquare(row, col));
+            if (code == NO_PIECE) {
+                empty++;
+                continue;
+            }
+            if (empty > 0) {
+                fen += static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            char symbol = pieceSymbols[static_cast<int>(codeType(code))];
+            fen += codeColor(code) == PieceColor::WHITE ? static_cast<char>(std::toupper(symbol)) : symbol;
         }
-
-        if (wouldMoveExposeKing(fromRow, fromCol, toRow, toCol, isWhiteTurn)) {
-            return false;
+        if (empty > 0) {
+            fen += static_cast<char>('0' + empty);
         }
+        if (row < 7) {
+            fen += '/';
+        }
+    }
 
-        int rookFromCol = isKingsideCastling ? 7 : 0;
-        int rookToCol = isKingsideCastling ? 5 : 3;
-
-        auto rook = std::move(board[fromRow][rookFromCol]);
-        board[fromRow][rookFromCol] = nullptr;
-        board[fromRow][rookToCol] = std::move(rook);
+    fen += position.sideToMove == PieceColor::WHITE ? " w " : " b ";
 
-        if (board[fromRow][rookToCol]) {
-            board[fromRow][rookToCol]->setHasMoved(true);
-        }
+    if (position.castlingRights == 0) {
+        fen += '-';
     }
-    else if (wouldMoveExposeKing(fromRow, fromCol, toRow, toCol, isWhiteTurn)) {
-        return false;
+    if (position.castlingRights & WHITE_KINGSIDE) fen += 'K';
+    if (position.castlingRights & WHITE_QUEENSIDE) fen += 'Q';
+    if (position.castlingRights & BLACK_KINGSIDE) fen += 'k';
+    if (position.castlingRights & BLACK_QUEENSIDE) fen += 'q';
+
+    fen += ' ';
+    if (position.enPassantCol >= 0) {
+        fen += static_cast<char>('a' + position.enPassantCol);
+        fen += static_cast<char>('8' - position.enPassantRow);
+    }
+    else {
+        fen += '-';
     }
 
-    bool isEnPassantCapture = false;
-    if (piece->getType() == PieceType::PAWN &&
-        toCol == enPassantCol &&
-        ((isWhiteTurn && fromRow == 3 && toRow == 2) ||
-            (!isWhiteTurn && fromRow == 4 && toRow == 5))) {
+    fen += ' ' + std::to_string(position.halfmoveClock);
+    fen += ' ' + std::to_string((initialPly + static_cast<int>(history.size())) / 2 + 1);
+    return fen;
+}
 
-        int capturedRow = isWhiteTurn ? 3 : 4;
-        board[capturedRow][enPassantCol] = nullptr;
-        isEnPassantCapture = true;
+void ChessBoard::putPiece(int square, PieceType type, PieceColor color) {
+    Bitboard bb = squareBB(square);
+    position.typeBB[0] |= bb;
+    position.typeBB[static_cast<int>(type)] |= bb;
+    position.colorBB[colorIndex(color)] |= bb;
+    PieceCode code = makePieceCode(type, color);
+    position.key ^= Zobrist::piece(code, square);
+    position.middlegameScore += PieceSquare::middlegame(code, square);
+    position.endgameScore += PieceSquare::endgame(code, square);
+    position.phase += PieceSquare::phase(code);
+
+    if (type == PieceType::KING) {
+        position.kingSquares[colorIndex(color)] = static_cast<signed char>(lsb(getPieces(PieceType::KING, color)));
     }
+}
 
-    auto movingPiece = std::move(board[fromRow][fromCol]);
-    board[fromRow][fromCol] = nullptr;
-    board[toRow][toCol] = std::move(movingPiece);
+void ChessBoard::clearSquare(int square) {
+    PieceCode code = position.pieceOn(square);
+    if (code == NO_PIECE) {
+        return;
+    }
 
-    if (board[toRow][toCol]) {
-        board[toRow][toCol]->setHasMoved(true);
+    Bitboard mask = ~squareBB(square);
+    position.typeBB[0] &= mask;
+    position.typeBB[static_cast<int>(codeType(code))] &= mask;
+    position.colorBB[colorIndex(codeColor(code))] &= mask;
+    position.key ^= Zobrist::piece(code, square);
+    position.middlegameScore -= PieceSquare::middlegame(code, square);
+    position.endgameScore -= PieceSquare::endgame(code, square);
+    position.phase -= PieceSquare::phase(code);
+
+    if (codeType(code) == PieceType::KING) {
+        Bitboard kings = getPieces(PieceType::KING, codeColor(code));
+        position.kingSquares[colorIndex(codeColor(code))] = static_cast<signed char>(kings ? lsb(kings) : -1);
     }
+}
 
-    if (board[toRow][toCol] && board[toRow][toCol]->getType() == PieceType::KING) {
-        if (board[toRow][toCol]->isWhite()) {
-            whiteKingMoved = true;
-        }
-        else {
-            blackKingMoved = true;
-        }
+std::unique_ptr<Piece> ChessBoard::createPiece(PieceType type, PieceColor color) {
+    switch (type) {
+    case PieceType::PAWN:   return std::make_unique<Pawn>(color);
+    case PieceType::ROOK:   return std::make_unique<Rook>(color);
+    case PieceType::KNIGHT: return std::make_unique<Knight>(color);
+    case PieceType::BISHOP: return std::make_unique<Bishop>(color);
+    case PieceType::QUEEN:  return std::make_unique<Queen>(color);
+    case PieceType::KING:   return std::make_unique<King>(color);
+    default:                return nullptr;
     }
-    else if (board[toRow][toCol] && board[toRow][toCol]->getType() == PieceType::ROOK) {
-        if (board[toRow][toCol]->isWhite()) {
-            if (fromCol == 0) whiteRook1Moved = true;
-            if (fromCol == 7) whiteRook2Moved = true;
-        }
-        else {
-            if (fromCol == 0) blackRook1Moved = true;
-            if (fromCol == 7) blackRook2Moved = true;
+}
+
+namespace {
+    /**
+     * @brief Shared piece objects handed out by ChessBoard::getPieceAt
+     *
+     * One instance per [moved][color][type], created on first use.
+     */
+    struct PieceFacades {
+        std::unique_ptr<Piece> pieces[2][2][7];
+
+        PieceFacades() {
+            for (int moved = 0; moved < 2; moved++) {
+                for (int type = 1; type < 7; type++) {
+                    pieces[moved][0][type] = ChessBoard::createPiece(static_cast<PieceType>(type), PieceColor::WHITE);
+                    pieces[moved][1][type] = ChessBoard::createPiece(static_cast<PieceType>(type), PieceColor::BLACK);
+                    pieces[moved][0][type]->setHasMoved(moved != 0);
+                    pieces[moved][1][type]->setHasMoved(moved != 0);
+                }
+            }
         }
+    };
+}
+
+const Piece* ChessBoard::getPieceAt(int row, int col) const {
+    static EmptyPiece emptyPiece;
+    if (!isValidPosition(row, col)) {
+        return &emptyPiece;
     }
 
-    if (board[toRow][toCol] && board[toRow][toCol]->getType() == PieceType::PAWN && abs(fromRow - toRow) == 2) {
-        enPassantCol = toCol;
-        enPassantRow = (fromRow + toRow) / 2;
+    int square = makeSquare(row, col);
+    PieceCode code = position.pieceOn(square);
+    if (code == NO_PIECE) {
+        return &emptyPiece;
     }
-    else {
-        enPassantCol = -1;
-        enPassantRow = -1;
+
+    PieceType type = codeType(code);
+    int moved = 0;
+    if (type == PieceType::KING || type == PieceType::ROOK) {
+        moved = (position.castlingRights & ~castlingRightsKept(square)) ? 0 : 1;
     }
 
-    return true;
+    static const PieceFacades facades;
+    return facades.pieces[moved][colorIndex(codeColor(code))][static_cast<int>(type)].get();
 }
 
-void ChessBoard::promotePawn(int row, int col, PieceType newType) {
+Bitboard ChessBoard::getPieces(PieceType type, PieceColor color) const {
+    return position.typeBB[static_cast<int>(type)] & position.colorBB[colorIndex(color)];
+}
+
+void ChessBoard::setPieceAt(int row, int col, std::unique_ptr<Piece> piece) {
+    if (isValidPosition(row, col)) {
+        stateVersion++;
+        int square = makeSquare(row, col);
+        clearSquare(square);
+        position.castlingRights &= castlingRightsKept(square);
+        if (piece && !piece->isEmpty()) {
+            putPiece(square, piece->getType(), piece->getColor());
+        }
+        position.key = computeKey();
+    }
+}
+
+bool ChessBoard::isValidPosition(int row, int col) const {
+    return row >= 0 && row < 8 && col >= 0 && col < 8;
+}
+
+void ChessBoard::getPossibleMoves(int row, int col, MoveList& moves) const {
     if (!isValidPosition(row, col)) {
         return;
     }
 
-    Piece* piece = getPieceAt(row, col);
-    if (!piece || piece->getType() != PieceType::PAWN) {
-        return;
+    int square = makeSquare(row, col);
+    PieceCode code = position.pieceOn(square);
+    if (code != NO_PIECE && codeColor(code) == position.sideToMove) {
+        for (const Move& move : getLegalMoves()) {
+            if (move.from() == square) {
+                moves.add(move);
+            }
+        }
     }
+    else if (code != NO_PIECE) {
+        int first = moves.size();
+        generatePieceMoves(square, codeType(code), codeColor(code), moves);
+        filterLegalMoves(square, computeCheckInfo(codeColor(code)), moves, first);
+    }
+}
 
-    PieceColor color = piece->getColor();
-    std::unique_ptr<Piece> newPiece;
+const MoveList& ChessBoard::getLegalMoves() const {
+    if (cachedVersion != stateVersion) {
+        CheckInfo info = computeCheckInfo(position.sideToMove);
+        cachedMoves.clear();
+        generateLegalMoves(position.sideToMove, info, cachedMoves);
+        cachedInCheck = info.checkers != 0;
+        cachedVersion = stateVersion;
+    }
+    return cachedMoves;
+}
 
-    switch (newType) {
-    case PieceType::QUEEN:
-        newPiece = std::make_unique<Queen>(color);
-        break;
+void ChessBoard::generateLegalMoves(MoveList& moves, MoveGenType kind) const {
+    generateLegalMoves(position.sideToMove, computeCheckInfo(position.sideToMove), moves, kind);
+}
+
+void ChessBoard::generateLegalMoves(PieceColor color, const CheckInfo& info, MoveList& moves, MoveGenType kind) const {
+    Bitboard pieces = position.colorBB[colorIndex(color)];
+    while (pieces) {
+        int square = popLsb(pieces);
+        int first = moves.size();
+        generatePieceMoves(square, typeOn(square), color, moves, kind);
+        filterLegalMoves(square, info, moves, first);
+    }
+}
+
+bool ChessBoard::isLegalMove(const Move& move) const {
+    int from = move.from();
+    if (move.isNone() || !(position.colorBB[colorIndex(position.sideToMove)] & squareBB(from))) {
+        return false;
+    }
+
+    MoveList moves;
+    generatePieceMoves(from, typeOn(from), position.sideToMove, moves);
+    filterLegalMoves(from, computeCheckInfo(position.sideToMove), moves, 0);
+    for (const Move& candidate : moves) {
+        if (candidate == move) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChessBoard::generatePieceMoves(int square, PieceType type, PieceColor color, MoveList& moves, MoveGenType kind) const {
+    int row = rowOf(square);
+    int col = colOf(square);
+    int us = colorIndex(color);
+    Bitboard targets = 0;
+    bool captures = kind != MoveGenType::QUIETS;
+    bool quiets = kind != MoveGenType::CAPTURES;
+
+    switch (type) {
     case PieceType::ROOK:
-        newPiece = std::make_unique<Rook>(color);
+        targets = Attacks::rook(square, position.typeBB[0]);
         break;
+
     case PieceType::BISHOP:
-        newPiece = std::make_unique<Bishop>(color);
+        targets = Attacks::bishop(square, position.typeBB[0]);
+        break;
+
+    case PieceType::QUEEN:
+        targets = Attacks::queen(square, position.typeBB[0]);
         break;
+
     case PieceType::KNIGHT:
-        newPiece = std::make_unique<Knight>(color);
+        targets = Attacks::knight(square);
         break;
-    default:
-        newPiece = std::make_unique<Queen>(color);
+
+    case PieceType::KING: {
+        targets = Attacks::king(square);
+
+        int homeRow = (color == PieceColor::WHITE) ? 7 : 0;
+        // Black's rights are shifted down onto the white bit positions
+        int rights = (color == PieceColor::WHITE) ? position.castlingRights : position.castlingRights >> 2;
+        Bitboard ownRooks = getPieces(PieceType::ROOK, color);
+        Bitboard occupied = position.typeBB[0];
+        if (quiets && square == makeSquare(homeRow, 4)) {
+            int kingsideRook = makeSquare(homeRow, 7);
+            int queensideRook = makeSquare(homeRow, 0);
+            if ((rights & WHITE_KINGSIDE) && (ownRooks & squareBB(kingsideRook)) &&
+                !(occupied & Attacks::between(square, kingsideRook))) {
+                moves.add(square, makeSquare(homeRow, 6), CASTLING);
+            }
+            if ((rights & WHITE_QUEENSIDE) && (ownRooks & squareBB(queensideRook)) &&
+                !(occupied & Attacks::between(square, queensideRook))) {
+                moves.add(square, makeSquare(homeRow, 2), CASTLING);
+            }
+        }
         break;
     }
 
-    setPieceAt(row, col, std::move(newPiece));
-}
+    case PieceType::PAWN: {
+        // White pawns move towards row 0
+        int direction = (color == PieceColor::WHITE) ? -1 : 1;
+        int startRow = (color == PieceColor::WHITE) ? 6 : 1;
+        int enPassantFrom = (color == PieceColor::WHITE) ? 3 : 4;
+        int nextRow = row + direction;
+        if (nextRow < 0 || nextRow > 7) {
+            break;
+        }
+        bool promotes = nextRow == 0 || nextRow == 7;
 
-bool ChessBoard::isKingInCheck(PieceColor kingColor) const {
-    int kingRow = -1, kingCol = -1;
+        auto addPawnMove = [&](int target) {
+            if (promotes) {
+                for (PieceType piece : { PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT }) {
+                    moves.add(Move::promotion(square, target, piece));
+                }
+            }
+            else {
+                moves.add(square, target);
+            }
+        };
 
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const Piece* piece = getPieceAt(row, col);
-            if (piece && piece->getType() == PieceType::KING && piece->getColor() == kingColor) {
-                kingRow = row;
-                kingCol = col;
-                break;
+        // A promotion counts with the captures, even without taking anything
+        if (!(position.typeBB[0] & squareBB(makeSquare(nextRow, col)))) {
+            if (promotes ? captures : quiets) {
+                addPawnMove(makeSquare(nextRow, col));
+            }
+            if (quiets && row == startRow && !(position.typeBB[0] & squareBB(makeSquare(row + 2 * direction, col)))) {
+                moves.add(square, makeSquare(row + 2 * direction, col));
             }
         }
-        if (kingRow != -1) break;
+
+        if (!captures) {
+            break;
+        }
+        Bitboard targetPawns = Attacks::pawn(color, square) & position.colorBB[1 - us];
+        while (targetPawns) {
+            addPawnMove(popLsb(targetPawns));
+        }
+
+        if (position.enPassantCol != -1 && row == enPassantFrom && abs(col - position.enPassantCol) == 1) {
+            moves.add(square, makeSquare(nextRow, position.enPassantCol), EN_PASSANT);
+        }
+        break;
     }
 
-    if (kingRow == -1) {
-        return false;
+    default:
+        break;
     }
 
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const Piece* piece = getPieceAt(row, col);
-            if (piece && !piece->isEmpty() && piece->getColor() != kingColor) {
-                auto moves = piece->getPossibleMoves(row, col, *this);
-                for (const auto& move : moves) {
-                    if (move.x == kingRow && move.y == kingCol) {
-                        return true;
-                    }
-                }
-            }
+    targets &= ~position.colorBB[us];
+    if (!captures) {
+        targets &= ~position.typeBB[0];
+    }
+    if (!quiets) {
+        targets &= position.colorBB[1 - us];
+    }
+    while (targets) {
+        moves.add(square, popLsb(targets));
+    }
+}
+
+ChessBoard::CheckInfo ChessBoard::computeCheckInfo(PieceColor color) const {
+    CheckInfo info;
+    info.checkers = 0;
+    info.checkMask = ~Bitboard(0);
+    info.pinned = 0;
+    info.pinCount = 0;
+
+    info.kingSquare = position.kingSquares[colorIndex(color)];
+    if (info.kingSquare == -1) {
+        return info;
+    }
+
+    int us = colorIndex(color);
+    Bitboard enemy = position.colorBB[1 - us];
+    Bitboard orthogonal = (position.typeBB[static_cast<int>(PieceType::ROOK)] | position.typeBB[static_cast<int>(PieceType::QUEEN)]) & enemy;
+    Bitboard diagonal = (position.typeBB[static_cast<int>(PieceType::BISHOP)] | position.typeBB[static_cast<int>(PieceType::QUEEN)]) & enemy;
+    Bitboard sliderCheckRay = 0;
+
+    // Enemy sliders that would see the king on an empty board; whatever
+    // stands between one of them and the king decides check or pin
+    Bitboard snipers = (Attacks::rook(info.kingSquare, 0) & orthogonal) | (Attacks::bishop(info.kingSquare, 0) & diagonal);
+    while (snipers) {
+        int sniper = popLsb(snipers);
+        Bitboard ray = Attacks::between(info.kingSquare, sniper) | squareBB(sniper);
+        Bitboard blockers = Attacks::between(info.kingSquare, sniper) & position.typeBB[0];
+
+        if (!blockers) {
+            info.checkers |= squareBB(sniper);
+            sliderCheckRay = ray;
+        }
+        else if (!(blockers & (blockers - 1)) && (blockers & position.colorBB[us])) {
+            info.pinned |= blockers;
+            info.pinnedSquares[info.pinCount] = lsb(blockers);
+            info.pinRays[info.pinCount] = ray;
+            info.pinCount++;
         }
     }
 
-    return false;
+    Bitboard leapers = attackersTo(info.kingSquare, position.typeBB[0]) & enemy &
+        (position.typeBB[static_cast<int>(PieceType::KNIGHT)] | position.typeBB[static_cast<int>(PieceType::PAWN)]);
+    info.checkers |= leapers;
+
+    int checkerCount = popCount(info.checkers);
+    if (checkerCount == 1) {
+        info.checkMask = leapers ? leapers : sliderCheckRay;
+    }
+    else if (checkerCount > 1) {
+        info.checkMask = 0;
+    }
+
+    return info;
 }
 
+Bitboard ChessBoard::attackersTo(int square, Bitboard occupancy) const {
+    Bitboard orthogonal = position.typeBB[static_cast<int>(PieceType::ROOK)] | position.typeBB[static_cast<int>(PieceType::QUEEN)];
+    Bitboard diagonal = position.typeBB[static_cast<int>(PieceType::BISHOP)] | position.typeBB[static_cast<int>(PieceType::QUEEN)];
 
-bool ChessBoard::wouldMoveExposeKing(int fromRow, int fromCol, int toRow, int toCol, bool isWhiteTurn) const {
-    ChessBoard tempBoard;
+    Bitboard attackers = (Attacks::rook(square, occupancy) & orthogonal) |
+        (Attacks::bishop(square, occupancy) & diagonal);
 
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            tempBoard.board[r][c] = nullptr;
-        }
+    attackers |= Attacks::knight(square) & position.typeBB[static_cast<int>(PieceType::KNIGHT)];
+    attackers |= Attacks::king(square) & position.typeBB[static_cast<int>(PieceType::KING)];
+
+    // A white pawn hits this square from where a black pawn on it would capture, and vice versa
+    Bitboard pawns = position.typeBB[static_cast<int>(PieceType::PAWN)];
+    attackers |= Attacks::pawn(PieceColor::BLACK, square) & pawns & position.colorBB[0];
+    attackers |= Attacks::pawn(PieceColor::WHITE, square) & pawns & position.colorBB[1];
+
+    return attackers;
+}
+
+Bitboard ChessBoard::attackedSquares(PieceColor color, Bitboard occupancy) const {
+    Bitboard own = position.colorBB[colorIndex(color)];
+    Bitboard orthogonal = (position.typeBB[static_cast<int>(PieceType::ROOK)] | position.typeBB[static_cast<int>(PieceType::QUEEN)]) & own;
+    Bitboard diagonal = (position.typeBB[static_cast<int>(PieceType::BISHOP)] | position.typeBB[static_cast<int>(PieceType::QUEEN)]) & own;
+
+    Bitboard attacked = Attacks::slidingAttacks(orthogonal, diagonal, occupancy);
+    attacked |= Attacks::pawnSet(color, position.typeBB[static_cast<int>(PieceType::PAWN)] & own);
+
+    Bitboard knights = position.typeBB[static_cast<int>(PieceType::KNIGHT)] & own;
+    while (knights) {
+        attacked |= Attacks::knight(popLsb(knights));
     }
 
-    const Piece* movingPiece = getPieceAt(fromRow, fromCol);
-    bool isPawnMove = movingPiece && movingPiece->getType() == PieceType::PAWN;
-    bool isEnPassantCapture = isPawnMove &&
-        toCol == enPassantCol &&
-        ((isWhiteTurn && fromRow == 3 && toRow == 2) ||
-            (!isWhiteTurn && fromRow == 4 && toRow == 5));
+    int kingSquare = position.kingSquares[colorIndex(color)];
+    if (kingSquare != -1) {
+        attacked |= Attacks::king(kingSquare);
+    }
+    return attacked;
+}
 
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            if (r == fromRow && c == fromCol) {
-                continue;
-            }
+void ChessBoard::filterLegalMoves(int square, const CheckInfo& info, MoveList& moves, int first) const {
+    if (info.kingSquare == -1) {
+        return;
+    }
 
-            if (isEnPassantCapture &&
-                ((isWhiteTurn && r == 3 && c == enPassantCol) ||
-                    (!isWhiteTurn && r == 4 && c == enPassantCol))) {
-                continue;
-            }
+    int us = colorIndex(colorOn(square));
+    Bitboard enemy = position.colorBB[1 - us];
+    PieceType type = typeOn(square);
 
-            const Piece* piece = getPieceAt(r, c);
-            if (piece && !piece->isEmpty()) {
-                PieceColor color = piece->getColor();
-                std::unique_ptr<Piece> newPiece;
-
-                switch (piece->getType()) {
-                case PieceType::PAWN:   newPiece = std::make_unique<Pawn>(color); break;
-                case PieceType::ROOK:   newPiece = std::make_unique<Rook>(color); break;
-                case PieceType::KNIGHT: newPiece = std::make_unique<Knight>(color); break;
-                case PieceType::BISHOP: newPiece = std::make_unique<Bishop>(color); break;
-                case PieceType::QUEEN:  newPiece = std::make_unique<Queen>(color); break;
-                case PieceType::KING:   newPiece = std::make_unique<King>(color); break;
-                default: continue;
-                }
+    // The king may not step onto any square the enemy attacks once the king
+    // itself no longer blocks a slider
+    Bitboard danger = 0;
+    if (type == PieceType::KING) {
+        PieceColor enemyColor = us == 0 ? PieceColor::BLACK : PieceColor::WHITE;
+        danger = attackedSquares(enemyColor, position.typeBB[0] & ~squareBB(square));
+    }
 
-                newPiece->setHasMoved(piece->getHasMoved());
-                tempBoard.board[r][c] = std::move(newPiece);
+    Bitboard allowed = info.checkMask;
+    if (info.pinned & squareBB(square)) {
+        for (int i = 0; i < info.pinCount; i++) {
+            if (info.pinnedSquares[i] == square) {
+                allowed &= info.pinRays[i];
             }
         }
     }
 
-    if (movingPiece && !movingPiece->isEmpty()) {
-        PieceColor color = movingPiece->getColor();
-        std::unique_ptr<Piece> newPiece;
+    int kept = first;
+    for (int i = first; i < moves.size(); i++) {
+        int target = moves[i].to();
+        bool legal;
+
+        if (type == PieceType::KING) {
+            legal = !(danger & squareBB(target));
 
-        switch (movingPiece->getType()) {
-        case PieceType::PAWN:   newPiece = std::make_unique<Pawn>(color); break;
-        case PieceType::ROOK:   newPiece = std::make_unique<Rook>(color); break;
-        case PieceType::KNIGHT: newPiece = std::make_unique<Knight>(color); break;
-        case PieceType::BISHOP: newPiece = std::make_unique<Bishop>(color); break;
-        case PieceType::QUEEN:  newPiece = std::make_unique<Queen>(color); break;
-        case PieceType::KING:   newPiece = std::make_unique<King>(color); break;
-        default: break;
+            if (legal && moves[i].flag() == CASTLING) {
+                int passed = (square + target) / 2;
+                legal = !info.checkers && !(danger & squareBB(passed));
+            }
+        }
+        else if (moves[i].flag() == EN_PASSANT) {
+            // En passant removes two pieces from one rank, so test the resulting occupancy directly
+            int capturedSquare = makeSquare(rowOf(square), colOf(target));
+            Bitboard occupancy = (position.typeBB[0] & ~squareBB(square) & ~squareBB(capturedSquare)) | squareBB(target);
+            legal = !(attackersTo(info.kingSquare, occupancy) & enemy & ~squareBB(capturedSquare));
+        }
+        else {
+            legal = (allowed & squareBB(target)) != 0;
         }
 
-        if (newPiece) {
-            newPiece->setHasMoved(true);
-            tempBoard.board[toRow][toCol] = std::move(newPiece);
+        if (legal) {
+            moves[kept++] = moves[i];
         }
     }
-
-    tempBoard.enPassantCol = this->enPassantCol;
-    tempBoard.enPassantRow = this->enPassantRow;
-
-    PieceColor kingColor = isWhiteTurn ? PieceColor::WHITE : PieceColor::BLACK;
-    bool result = tempBoard.isKingInCheck(kingColor);
-    return result;
+    moves.resize(kept);
 }
 
-bool ChessBoard::isCheckmate(bool isWhiteTurn) const {
-    PieceColor kingColor = isWhiteTurn ? PieceColor::WHITE : PieceColor::BLACK;
-
-    if (!isKingInCheck(kingColor)) {
+bool ChessBoard::findMove(int fromRow, int fromCol, int toRow, int toCol, PieceType promotion, Move& move) const {
+    if (!isValidPosition(fromRow, fromCol) || !isValidPosition(toRow, toCol)) {
         return false;
     }
 
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const Piece* piece = getPieceAt(row, col);
-            if (piece && !piece->isEmpty() && piece->getColor() == kingColor) {
-                auto moves = getPossibleMoves(row, col);
-
-                for (const auto& move : moves) {
-                    if (!wouldMoveExposeKing(row, col, move.x, move.y, isWhiteTurn)) {
-                        return false;
-                    }
-                }
-            }
+    int toSquare = makeSquare(toRow, toCol);
+
+    MoveList possibleMoves;
+    getPossibleMoves(fromRow, fromCol, possibleMoves);
+    for (const Move& candidate : possibleMoves) {
+        if (candidate.to() == toSquare && (!candidate.isPromotion() || candidate.promotionType() == promotion)) {
+            move = candidate;
+            return true;
         }
     }
+    return false;
+}
 
+bool ChessBoard::makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceType promotion) {
+    Move move;
+    if (!findMove(fromRow, fromCol, toRow, toCol, promotion, move)) {
+        return false;
+    }
+
+    makeLegalMove(move);
     return true;
 }
 
-bool ChessBoard::isStalemate(bool isWhiteTurn) const {
-    PieceColor kingColor = isWhiteTurn ? PieceColor::WHITE : PieceColor::BLACK;
-
-    if (isKingInCheck(kingColor)) {
+bool ChessBoard::makeMove(const Move& move) {
+    MoveList possibleMoves;
+    getPossibleMoves(rowOf(move.from()), colOf(move.from()), possibleMoves);
+    if (!possibleMoves.contains(move)) {
         return false;
     }
 
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const Piece* piece = getPieceAt(row, col);
-            if (piece && !piece->isEmpty() && piece->getColor() == kingColor) {
-                auto moves = getPossibleMoves(row, col);
-
-                for (const auto& move : moves) {
-                    if (!wouldMoveExposeKing(row, col, move.x, move.y, isWhiteTurn)) {
-                        return false;
-                    }
-                }
-            }
-        }
+    makeLegalMove(move);
+    return true;
+}
+
+void ChessBoard::makeLegalMove(const Move& move) {
+    keyHistory.push_back(position.key);
+    history.push_back({ move, applyMove(move) });
+}
+
+bool ChessBoard::unmakeMove() {
+    if (history.empty()) {
+        return false;
     }
 
+    const MoveRecord& record = history.back();
+    revertMove(record.move, record.undo);
+    history.pop_back();
+    keyHistory.pop_back();
     return true;
 }
 
-bool ChessBoard::isInCheck(bool isWhitePlayer) const {
-    sf::Vector2i kingPos(-1, -1);
+UndoInfo ChessBoard::applyMove(const Move& move) {
+    int from = move.from();
+    int to = move.to();
+    stateVersion++;
+
+    UndoInfo undo;
+    undo.movedType = typeOn(from);
+    undo.castlingRights = position.castlingRights;
+    undo.sideToMove = position.sideToMove;
+    undo.key = position.key;
+    undo.halfmoveClock = position.halfmoveClock;
+    position.key ^= Zobrist::castling(position.castlingRights) ^ enPassantKey();
+    undo.enPassantCol = position.enPassantCol;
+    undo.enPassantRow = position.enPassantRow;
+
+    PieceColor color = colorOn(from);
+    int capturedSquare = move.flag() == EN_PASSANT ? makeSquare(rowOf(from), colOf(to)) : to;
+    undo.capturedType = typeOn(capturedSquare);
+    undo.capturedSquare = static_cast<signed char>(capturedSquare);
+
+    if (undo.movedType == PieceType::PAWN || undo.capturedType != PieceType::NONE) {
+        position.halfmoveClock = 0;
+    }
+    else if (position.halfmoveClock < 0xFFFF) {
+        position.halfmoveClock++;
+    }
 
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const Piece* piece = getPieceAt(row, col);
-            if (piece && piece->getType() == PieceType::KING &&
-                ((isWhitePlayer && piece->isWhite()) || (!isWhitePlayer && piece->isBlack()))) {
-                kingPos = sf::Vector2i(row, col);
-                break;
-            }
-        }
-        if (kingPos.x != -1) break;
+    if (undo.capturedType != PieceType::NONE) {
+        clearSquare(capturedSquare);
+    }
+    clearSquare(from);
+    putPiece(to, move.isPromotion() ? move.promotionType() : undo.movedType, color);
+
+    if (move.flag() == CASTLING) {
+        int row = rowOf(from);
+        bool isKingsideCastling = colOf(to) > colOf(from);
+        clearSquare(makeSquare(row, isKingsideCastling ? 7 : 0));
+        putPiece(makeSquare(row, isKingsideCastling ? 5 : 3), PieceType::ROOK, color);
     }
 
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 8; col++) {
-            const Piece* piece = getPieceAt(row, col);
-            if (piece && !piece->isEmpty() &&
-                ((isWhitePlayer && piece->isBlack()) || (!isWhitePlayer && piece->isWhite()))) {
+    position.castlingRights &= castlingRightsKept(from) & castlingRightsKept(to);
 
-                auto moves = getPossibleMoves(row, col);
+    if (undo.movedType == PieceType::PAWN && abs(rowOf(from) - rowOf(to)) == 2) {
+        position.enPassantCol = static_cast<signed char>(colOf(to));
+        position.enPassantRow = static_cast<signed char>((rowOf(from) + rowOf(to)) / 2);
+    }
+    else {
+        position.enPassantCol = -1;
+        position.enPassantRow = -1;
+    }
 
-                for (const auto& move : moves) {
-                    if (move.x == kingPos.x && move.y == kingPos.y) {
-                        return true;
-                    }
-                }
-            }
-        }
+    PieceColor next = (color == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
+    if (position.sideToMove != next) {
+        position.sideToMove = next;
+        position.key ^= Zobrist::side();
     }
+    position.key ^= Zobrist::castling(position.castlingRights) ^ enPassantKey();
 
-    return false;
+    return undo;
 }
 
-std::unique_ptr<Piece> ChessBoard::removePieceAt(int row, int col) {
-    if (row < 0 || row >= 8 || col < 0 || col >= 8) {
-        return nullptr;
+void ChessBoard::revertMove(const Move& move, const UndoInfo& undo) {
+    int from = move.from();
+    int to = move.to();
+    stateVersion++;
+    PieceColor color = colorOn(to);
+
+    if (move.flag() == CASTLING) {
+        int row = rowOf(from);
+        bool isKingsideCastling = colOf(to) > colOf(from);
+        clearSquare(makeSquare(row, isKingsideCastling ? 5 : 3));
+        putPiece(makeSquare(row, isKingsideCastling ? 7 : 0), PieceType::ROOK, color);
     }
 
-    std::unique_ptr<Piece> removedPiece = std::move(board[row][col]);
+    clearSquare(to);
+    putPiece(from, undo.movedType, color);
 
-    board[row][col] = nullptr;
+    if (undo.capturedType != PieceType::NONE) {
+        PieceColor capturedColor = (color == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
+        putPiece(undo.capturedSquare, undo.capturedType, capturedColor);
+    }
 
-    return removedPiece;
+    position.castlingRights = undo.castlingRights;
+    position.enPassantCol = undo.enPassantCol;
+    position.enPassantRow = undo.enPassantRow;
+    position.sideToMove = undo.sideToMove;
+    position.halfmoveClock = undo.halfmoveClock;
+    position.key = undo.key;
 }
 
-bool ChessBoard::canCastleKingside(bool isWhite) const {
-    int row = isWhite ? 7 : 0;
+std::uint64_t ChessBoard::enPassantKey() const {
+    if (position.enPassantCol == -1) {
+        return 0;
+    }
 
-    if (isWhite && (whiteKingMoved || whiteRook2Moved)) return false;
-    if (!isWhite && (blackKingMoved || blackRook2Moved)) return false;
+    // The pawn that made the double step stands one row past the en passant square
+    int pawnRow = position.enPassantRow + (position.sideToMove == PieceColor::WHITE ? 1 : -1);
+    Bitboard capturers = getPieces(PieceType::PAWN, position.sideToMove);
+    for (int offset : {-1, 1}) {
+        int col = position.enPassantCol + offset;
+        if (col >= 0 && col < 8 && (capturers & squareBB(makeSquare(pawnRow, col)))) {
+            return Zobrist::enPassant(position.enPassantCol);
+        }
+    }
+    return 0;
+}
 
-    if (!isPathClear(row, 4, row, 7)) return false;
+std::uint64_t ChessBoard::computeKey() const {
+    std::uint64_t result = 0;
+    Bitboard occupied = position.typeBB[0];
+    while (occupied) {
+        int square = popLsb(occupied);
+        result ^= Zobrist::piece(position.pieceOn(square), square);
+    }
 
-    PieceColor kingColor = isWhite ? PieceColor::WHITE : PieceColor::BLACK;
-    if (isKingInCheck(kingColor)) return false;
+    result ^= Zobrist::castling(position.castlingRights) ^ enPassantKey();
+    if (position.sideToMove == PieceColor::BLACK) {
+        result ^= Zobrist::side();
+    }
+    return result;
+}
 
-    if (isPathUnderAttack(row, 4, 6, kingColor)) return false;
+void ChessBoard::setCastlingRights(int rights) {
+    stateVersion++;
+    position.castlingRights = static_cast<std::uint8_t>(rights & ALL_CASTLING);
+    position.key = computeKey();
+}
 
-    return true;
+void ChessBoard::setSideToMove(PieceColor color) {
+    stateVersion++;
+    position.sideToMove = (color == PieceColor::BLACK) ? PieceColor::BLACK : PieceColor::WHITE;
+    position.key = computeKey();
 }
 
-bool ChessBoard::canCastleQueenside(bool isWhite) const {
-    int row = isWhite ? 7 : 0;
+void ChessBoard::promotePawn(int row, int col, PieceType newType) {
+    if (!isValidPosition(row, col)) {
+        return;
+    }
+
+    int square = makeSquare(row, col);
+    if (typeOn(square) != PieceType::PAWN) {
+        return;
+    }
 
-    if (isWhite && (whiteKingMoved || whiteRook1Moved)) return false;
-    if (!isWhite && (blackKingMoved || blackRook1Moved)) return false;
+    stateVersion++;
+    PieceColor color = colorOn(square);
+    switch (newType) {
+    case PieceType::QUEEN:
+    case PieceType::ROOK:
+    case PieceType::BISHOP:
+    case PieceType::KNIGHT:
+        break;
+    default:
+        newType = PieceType::QUEEN;
+        break;
+    }
 
-    if (!isPathClear(row, 0, row, 4)) return false;
+    clearSquare(square);
+    putPiece(square, newType, color);
+}
 
-    PieceColor kingColor = isWhite ? PieceColor::WHITE : PieceColor::BLACK;
-    if (isKingInCheck(kingColor)) return false;
+bool ChessBoard::isKingInCheck(PieceColor kingColor) const {
+    int kingSquare = position.kingSquares[colorIndex(kingColor)];
+    if (kingSquare == -1) {
+        return false;
+    }
 
-    if (isPathUnderAttack(row, 2, 4, kingColor)) return false;
+    PieceColor opponentColor = (kingColor == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
+    return isSquareAttacked(kingSquare, opponentColor);
+}
 
-    return true;
+bool ChessBoard::isSquareAttacked(int square, PieceColor byColor) const {
+    return (attackersTo(square, position.typeBB[0]) & position.colorBB[colorIndex(byColor)]) != 0;
 }
 
-bool ChessBoard::isPathClear(int startRow, int startCol, int endRow, int endCol) const {
-    if (startRow != endRow) {
-        int colDir = 0;
-        int rowDir = (endRow > startRow) ? 1 : -1;
+int ChessBoard::staticExchange(const Move& move) const {
+    if (move.flag() == CASTLING) {
+        return 0;
+    }
 
-        for (int r = startRow + rowDir; r != endRow; r += rowDir) {
-            if (!getPieceAt(r, startCol)->isEmpty()) {
-                return false;
-            }
-        }
+    int from = move.from();
+    int to = move.to();
+    Bitboard occupancy = position.typeBB[0] & ~squareBB(from);
+
+    // gain[d]: what the side making capture d stands to win if the
+    // exchange stopped right after it
+    int gain[32];
+    int depth = 0;
+    int onSquare = exchangeValues[static_cast<int>(typeOn(from))];
+    if (move.flag() == EN_PASSANT) {
+        occupancy &= ~squareBB(makeSquare(rowOf(from), colOf(to)));
+        gain[0] = exchangeValues[static_cast<int>(PieceType::PAWN)];
     }
     else {
-        int colDir = (endCol > startCol) ? 1 : -1;
+        gain[0] = exchangeValues[static_cast<int>(typeOn(to))];
+    }
+    if (move.isPromotion()) {
+        onSquare = exchangeValues[static_cast<int>(move.promotionType())];
+        gain[0] += onSquare - exchangeValues[static_cast<int>(PieceType::PAWN)];
+    }
 
-        for (int c = startCol + colDir; c != endCol; c += colDir) {
-            if (!getPieceAt(startRow, c)->isEmpty()) {
-                return false;
+    int side = 1 - colorIndex(colorOn(from));
+    while (depth < 31) {
+        // Recomputing the attackers from the shrinking occupancy uncovers
+        // sliders that stood behind the pieces already exchanged
+        Bitboard attackers = attackersTo(to, occupancy) & occupancy;
+        Bitboard ours = attackers & position.colorBB[side];
+        if (!ours) {
+            break;
+        }
+
+        PieceType type = PieceType::KING;
+        Bitboard candidates = 0;
+        for (PieceType candidate : exchangeOrder) {
+            candidates = ours & position.typeBB[static_cast<int>(candidate)];
+            if (candidates) {
+                type = candidate;
+                break;
             }
         }
+        // The king may only take last, on a square nobody defends any more
+        if (type == PieceType::KING && (attackers & position.colorBB[1 - side])) {
+            break;
+        }
+
+        depth++;
+        gain[depth] = onSquare - gain[depth - 1];
+        onSquare = exchangeValues[static_cast<int>(type)];
+        occupancy &= ~(candidates & (~candidates + 1));
+        side = 1 - side;
     }
 
-    return true;
+    // Either side may stop recapturing whenever going on would cost it
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+    return gain[0];
 }
 
-bool ChessBoard::isPathUnderAttack(int row, int startCol, int endCol, PieceColor kingColor) const {
-    PieceColor opponentColor = (kingColor == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
+Bitboard ChessBoard::getHangingPieces(PieceColor color) const {
+    int us = colorIndex(color);
+    Bitboard hanging = 0;
+    Bitboard pieces = position.colorBB[us] & ~position.typeBB[static_cast<int>(PieceType::KING)];
+    while (pieces) {
+        int square = popLsb(pieces);
+        Bitboard attackers = attackersTo(square, position.typeBB[0]) & position.colorBB[1 - us];
+        if (!attackers) {
+            continue;
+        }
 
-    for (int col = startCol; col <= endCol; col++) {
-        for (int r = 0; r < 8; r++) {
-            for (int c = 0; c < 8; c++) {
-                const Piece* piece = getPieceAt(r, c);
-                if (piece && !piece->isEmpty() && piece->getColor() == opponentColor) {
-                    auto moves = piece->getPossibleMoves(r, c, *this);
-
-                    for (const auto& move : moves) {
-                        if (move.x == row && move.y == col) {
-                            return true;
-                        }
-                    }
+        // Taking with the least valuable attacker is the test that matters
+        for (PieceType type : exchangeOrder) {
+            Bitboard candidates = attackers & position.typeBB[static_cast<int>(type)];
+            if (candidates) {
+                // A pawn taking on the last row promotes, which the exchange must count
+                int from = lsb(candidates);
+                bool promotes = type == PieceType::PAWN && (rowOf(square) == 0 || rowOf(square) == 7);
+                Move capture = promotes ? Move::promotion(from, square, PieceType::QUEEN) : Move(from, square);
+                if (staticExchange(capture) > 0) {
+                    hanging |= squareBB(square);
                 }
+                break;
             }
         }
     }
+    return hanging;
+}
 
-    return false;
+GameStatus ChessBoard::evaluateStatus(PieceColor side) const {
+    GameStatus status;
+    if (side == position.sideToMove) {
+        status.legalMoveCount = getLegalMoves().size();
+        status.inCheck = cachedInCheck;
+    }
+    else {
+        CheckInfo info = computeCheckInfo(side);
+        MoveList moves;
+        generateLegalMoves(side, info, moves);
+        status.legalMoveCount = moves.size();
+        status.inCheck = info.checkers != 0;
+    }
+
+    status.checkmate = status.inCheck && status.legalMoveCount == 0;
+    status.stalemate = !status.inCheck && status.legalMoveCount == 0;
+    if (status.checkmate) {
+        status.drawReason = DrawReason::NONE;
+    }
+    else if (status.stalemate) {
+        status.drawReason = DrawReason::STALEMATE;
+    }
+    else if (hasInsufficientMaterial()) {
+        status.drawReason = DrawReason::INSUFFICIENT_MATERIAL;
+    }
+    else if (isFiftyMoveDraw()) {
+        status.drawReason = DrawReason::FIFTY_MOVE_RULE;
+    }
+    else if (getRepetitionCount() >= 2) {
+        status.drawReason = DrawReason::THREEFOLD_REPETITION;
+    }
+    else {
+        status.drawReason = DrawReason::NONE;
+    }
+    return status;
+}
+
+int ChessBoard::getRepetitionCount() const {
+    // keyHistory[plies - n] is the position n plies ago. Keys before the last
+    // irreversible move cannot match, and a repeat needs the same side to
+    // move after at least four plies.
+    int plies = static_cast<int>(keyHistory.size());
+    int reach = std::min<int>(position.halfmoveClock, plies);
+    int count = 0;
+    for (int back = 4; back <= reach; back += 2) {
+        if (keyHistory[plies - back] == position.key) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool ChessBoard::hasInsufficientMaterial() const {
+    if (position.typeBB[static_cast<int>(PieceType::PAWN)] | position.typeBB[static_cast<int>(PieceType::ROOK)] |
+        position.typeBB[static_cast<int>(PieceType::QUEEN)]) {
+        return false;
+    }
+
+    Bitboard bishops = position.typeBB[static_cast<int>(PieceType::BISHOP)];
+    Bitboard minors = bishops | position.typeBB[static_cast<int>(PieceType::KNIGHT)];
+    if (popCount(minors) <= 1) {
+        return true;
+    }
+    return minors == bishops && ((bishops & LIGHT_SQUARES_BB) == 0 || (bishops & ~LIGHT_SQUARES_BB) == 0);
+}
+
+bool ChessBoard::isCheckmate(bool isWhiteTurn) const {
+    return evaluateStatus(isWhiteTurn ? PieceColor::WHITE : PieceColor::BLACK).checkmate;
+}
+
+bool ChessBoard::isStalemate(bool isWhiteTurn) const {
+    return evaluateStatus(isWhiteTurn ? PieceColor::WHITE : PieceColor::BLACK).stalemate;
+}
+
+bool ChessBoard::isInCheck(bool isWhitePlayer) const {
+    PieceColor kingColor = isWhitePlayer ? PieceColor::WHITE : PieceColor::BLACK;
+    if (kingColor == position.sideToMove) {
+        getLegalMoves();
+        return cachedInCheck;
+    }
+    return isKingInCheck(kingColor);
+}
+
+std::unique_ptr<Piece> ChessBoard::removePieceAt(int row, int col) {
+    if (row < 0 || row >= 8 || col < 0 || col >= 8) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Piece> removedPiece;
+    const Piece* piece = getPieceAt(row, col);
+    if (!piece->isEmpty()) {
+        removedPiece = createPiece(piece->getType(), piece->getColor());
+        removedPiece->setHasMoved(piece->getHasMoved());
+    }
+
+    int square = makeSquare(row, col);
+    clearSquare(square);
+    position.castlingRights &= castlingRightsKept(square);
+    position.key = computeKey();
+    stateVersion++;
+
+    return removedPiece;
 }
\ No newline at end of file
@@ -6,10 +6,108 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
-#include <SFML/System/Vector2.hpp>
+#include "Bitboard.h"
+#include "Move.h"
 #include "Piece.h"
+#include "PieceCode.h"
+#include "PieceSquare.h"
+#include "Position.h"
+
+ /**
+  * @struct UndoInfo
+  * @brief State needed to take back a move applied in place
+  *
+  * Filled in when a move is applied and consumed when it is reverted, so
+  * trying a move and taking it back allocates nothing.
+  */
+struct UndoInfo {
+    PieceType movedType;     ///< Type of the piece that moved (a promoted pawn is recorded as a pawn)
+    PieceType capturedType;  ///< Type of the captured piece, NONE if nothing was captured
+    signed char capturedSquare; ///< Square the captured piece stood on (differs from the target on en passant)
+    signed char enPassantCol;   ///< En passant column before the move
+    signed char enPassantRow;   ///< En passant row before the move
+    unsigned char castlingRights; ///< Castling rights before the move
+    PieceColor sideToMove;   ///< Side to move before the move
+    std::uint16_t halfmoveClock; ///< Halfmove clock before the move
+    std::uint64_t key;       ///< Position key before the move
+};
+
+/**
+ * @struct MoveRecord
+ * @brief A move made through ChessBoard::makeMove together with its undo data
+ */
+struct MoveRecord {
+    Move move;      ///< The move as generated
+    UndoInfo undo;  ///< State needed to take the move back
+};
+
+ /**
+  * @enum CastlingRight
+  * @brief Bits of the castling rights held by ChessBoard
+  *
+  * A right is lost once the king or the rook concerned moves or the rook
+  * is captured on its home square.
+  */
+enum CastlingRight {
+    WHITE_KINGSIDE = 1,   ///< White may castle short (king e1-g1, rook h1-f1)
+    WHITE_QUEENSIDE = 2,  ///< White may castle long (king e1-c1, rook a1-d1)
+    BLACK_KINGSIDE = 4,   ///< Black may castle short (king e8-g8, rook h8-f8)
+    BLACK_QUEENSIDE = 8,  ///< Black may castle long (king e8-c8, rook a8-d8)
+    ALL_CASTLING = 15     ///< Every right, as in the initial position
+};
+
+/**
+ * @enum DrawReason
+ * @brief Why a position is drawn
+ */
+enum class DrawReason {
+    NONE,                  ///< The game is not drawn
+    STALEMATE,             ///< The side to move has no legal move and is not in check
+    INSUFFICIENT_MATERIAL, ///< Neither side has the material left to mate
+    FIFTY_MOVE_RULE,       ///< 100 plies without a capture or pawn move
+    THREEFOLD_REPETITION   ///< The position occurred for the third time
+};
+
+/**
+ * @enum MoveGenType
+ * @brief Which legal moves a generation pass produces
+ *
+ * CAPTURES and QUIETS split ALL without overlap, so a search can generate
+ * the captures first and the quiet moves only if it still needs them.
+ */
+enum class MoveGenType {
+    ALL,       ///< Every legal move
+    CAPTURES,  ///< Captures, en passant and promotions
+    QUIETS     ///< Every other move, castling included
+};
+
+/**
+ * @struct GameStatus
+ * @brief Check, mate and draw state of one side, as computed by ChessBoard::evaluateStatus
+ */
+struct GameStatus {
+    bool inCheck;           ///< The side's king is attacked
+    int legalMoveCount;     ///< Number of legal moves of the side (promotions count per piece)
+    bool checkmate;         ///< In check with no legal move
+    bool stalemate;         ///< Not in check with no legal move
+    DrawReason drawReason;  ///< Why the game is drawn, NONE if it is not
+
+    /**
+     * @brief Checks if the game is drawn
+     * @return true if drawReason is not NONE
+     */
+    bool isDraw() const { return drawReason != DrawReason::NONE; }
+
+    /**
+     * @brief Checks if the game has ended
+     * @return true on checkmate or a draw
+     */
+    bool isOver() const { return checkmate || isDraw(); }
+};
 
  /**
   * @class ChessBoard
@@ -19,68 +117,128 @@
   * and supports special rules like castling, en passant, and pawn promotion.
   */
 class ChessBoard {
-public:
-    // Delete default copy constructor
+private:
     /**
-     * @brief Copy constructor is deleted due to the use of unique_ptr
+     * @brief Piece placement and game state
+     *
+     * Everything that defines the position lives here, so a snapshot is a
+     * copy of this one value (see getPosition()/setPosition()).
      */
-    ChessBoard(const ChessBoard&) = delete;
+    Position position;
 
     /**
-     * @brief Assignment operator is deleted due to the use of unique_ptr
+     * @brief Moves made through makeMove(), most recent last
      */
-    ChessBoard& operator=(const ChessBoard&) = delete;
-private:
+    std::vector<MoveRecord> history;
+
     /**
-     * @brief Two-dimensional array storing chess pieces on the board
+     * @brief Position key before each move in history, indexed by ply
      *
-     * Each position on the board can contain a pointer to a piece or nullptr
-     * if the square is empty.
+     * Kept apart from history so a repetition scan walks 8 bytes per ply.
+     * After setPosition() with keys it starts with the keys of positions
+     * whose moves are not in history.
      */
-    std::unique_ptr<Piece> board[8][8];
+    std::vector<std::uint64_t> keyHistory;
 
-    // Additional game states
     /**
-     * @brief Flag indicating whether the white king has moved (relevant for castling)
+     * @brief Game ply of the position the history starts from
+     *
+     * Counts from 0 at white's first move; gives the fullmove number in toFen().
      */
-    bool whiteKingMoved;
+    int initialPly;
 
     /**
-     * @brief Flag indicating whether the black king has moved (relevant for castling)
+     * @brief Counter advanced by every change to the position
      */
-    bool blackKingMoved;
+    std::uint64_t stateVersion;
 
+    // Legal move cache, filled on demand by getLegalMoves()
     /**
-     * @brief Flag indicating whether the left white rook has moved (relevant for castling)
+     * @brief Legal moves of the side to move
      */
-    bool whiteRook1Moved;
+    mutable MoveList cachedMoves;
 
     /**
-     * @brief Flag indicating whether the right white rook has moved (relevant for castling)
+     * @brief Whether the side to move was in check when the cache was filled
      */
-    bool whiteRook2Moved;
+    mutable bool cachedInCheck;
 
     /**
-     * @brief Flag indicating whether the left black rook has moved (relevant for castling)
+     * @brief stateVersion the cache was filled for
      */
-    bool blackRook1Moved;
+    mutable std::uint64_t cachedVersion;
 
+    // Helper methods
     /**
-     * @brief Flag indicating whether the right black rook has moved (relevant for castling)
+     * @brief Returns the bitboard index of a color
+     * @param color WHITE or BLACK
+     * @return 0 for white, 1 for black
      */
-    bool blackRook2Moved;
+    static int colorIndex(PieceColor color) { return color == PieceColor::WHITE ? 0 : 1; }
 
     /**
-     * @brief Column for en passant capture (-1 if unavailable)
+     * @brief Returns the type of the piece standing on a square
+     * @param square Square index (0-63)
+     * @return Piece type or PieceType::NONE if the square is empty
      */
-    int enPassantCol;
+    PieceType typeOn(int square) const { return position.typeOn(square); }
 
     /**
-     * @brief Row for en passant capture
+     * @brief Returns the color of the piece standing on a square
+     * @param square Square index (0-63)
+     * @return Piece color or PieceColor::NONE if the square is empty
      */
-    int enPassantRow;
+    PieceColor colorOn(int square) const { return position.colorOn(square); }
+
+    /**
+     * @brief Adds a piece to the bitboards and updates the king square and key
+     * @param square Target square (must be empty)
+     * @param type Type of the piece
+     * @param color Color of the piece
+     */
+    void putPiece(int square, PieceType type, PieceColor color);
+
+    /**
+     * @brief Removes whatever piece stands on a square from the bitboards
+     * @param square Square to clear
+     */
+    void clearSquare(int square);
+
+    /**
+     * @brief Applies a move in place without validating it
+     *
+     * Handles captures, en passant, the rook part of castling, promotion,
+     * castling rights and the en passant state, as told by the move's flag.
+     *
+     * @param move Move to apply
+     * @return Data needed by revertMove() to take the move back
+     */
+    UndoInfo applyMove(const Move& move);
+
+    /**
+     * @brief Takes back a move applied with applyMove()
+     * @param move The move that was applied
+     * @param undo Data returned by applyMove()
+     */
+    void revertMove(const Move& move, const UndoInfo& undo);
+
+    /**
+     * @brief Returns the en passant part of the position key
+     *
+     * The column is only hashed while a pawn of the side to move stands
+     * next to the pawn that just made a double step, so positions that
+     * differ only in an unusable en passant chance share a key.
+     *
+     * @return Key of the en passant column or 0
+     */
+    std::uint64_t enPassantKey() const;
+
+    /**
+     * @brief Computes the position key from scratch
+     * @return Zobrist key of the current position
+     */
+    std::uint64_t computeKey() const;
 
-    // Helper methods
     /**
      * @brief Checks if the given position is within the board boundaries
      * @param row Row number (0-7)
@@ -89,15 +247,6 @@ private:
      */
     bool isValidPosition(int row, int col) const;
 
-    /**
-     * @brief Checks if the piece at the given position belongs to the current player
-     * @param row Row number
-     * @param col Column number
-     * @param isWhiteTurn Whether it's white's turn
-     * @return true if the piece belongs to the current player, false otherwise
-     */
-    bool isPieceOfCurrentPlayer(int row, int col, bool isWhiteTurn) const;
-
     // Check-related verifications
     /**
      * @brief Checks if the king of the given color is in check
@@ -107,78 +256,212 @@ private:
     bool isKingInCheck(PieceColor color) const;
 
     /**
-     * @brief Checks if a move would expose the king to attack
-     * @param fromRow Starting row
-     * @param fromCol Starting column
-     * @param toRow Target row
-     * @param toCol Target column
-     * @param isWhiteTurn Whether it's white's turn
-     * @return true if the move would expose the king, false otherwise
+     * @struct CheckInfo
+     * @brief Check and pin data of one side, computed once per position
+     *
+     * A non-king move is legal when its target lies in checkMask and, for a
+     * pinned piece, on its pin ray. King moves are checked against enemy
+     * attacks directly and en passant captures against the resulting
+     * occupancy.
+     */
+    struct CheckInfo {
+        int kingSquare;          ///< Square of the king, -1 if the side has no king
+        Bitboard checkers;       ///< Enemy pieces giving check
+        Bitboard checkMask;      ///< Targets that resolve the check (all squares when not in check)
+        Bitboard pinned;         ///< Own pieces pinned to the king
+        int pinCount;            ///< Number of entries in pinnedSquares/pinRays
+        int pinnedSquares[8];    ///< Square of each pinned piece
+        Bitboard pinRays[8];     ///< Squares each pinned piece may still move to
+    };
+
+    /**
+     * @brief Computes checkers, the check evasion mask and pins for a side
+     * @param color Side whose king is examined
+     * @return Check and pin data for the side
      */
-    bool wouldMoveExposeKing(int fromRow, int fromCol, int toRow, int toCol, bool isWhiteTurn) const;
+    CheckInfo computeCheckInfo(PieceColor color) const;
 
     /**
-     * @brief Checks if the king can castle kingside (short castling)
-     * @param isWhite Whether we're checking for the white king
-     * @return true if castling is possible, false otherwise
+     * @brief Returns every piece of either color attacking a square
+     * @param square Target square
+     * @param occupancy Occupied squares used to block sliding pieces
+     * @return Bitboard of attacking pieces
      */
-    bool canCastleKingside(bool isWhite) const;
+    Bitboard attackersTo(int square, Bitboard occupancy) const;
 
     /**
-     * @brief Checks if the king can castle queenside (long castling)
-     * @param isWhite Whether we're checking for the white king
-     * @return true if castling is possible, false otherwise
+     * @brief Returns every square attacked by a side
+     * @param color Attacking side
+     * @param occupancy Occupied squares used to block sliding pieces
+     * @return Bitboard of attacked squares
      */
-    bool canCastleQueenside(bool isWhite) const;
+    Bitboard attackedSquares(PieceColor color, Bitboard occupancy) const;
 
     /**
-     * @brief Checks if the path between two positions is clear of pieces
-     * @param startRow Starting row
-     * @param startCol Starting column
-     * @param endRow Ending row
-     * @param endCol Ending column
-     * @return true if the path is clear, false otherwise
+     * @brief Removes the illegal moves from a piece's pseudo-legal moves
+     * @param square Square of the moving piece
+     * @param info Check and pin data of the moving side
+     * @param moves Move list, filtered in place from index first onwards
+     * @param first Index of the piece's first move in the list
      */
-    bool isPathClear(int startRow, int startCol, int endRow, int endCol) const;
+    void filterLegalMoves(int square, const CheckInfo& info, MoveList& moves, int first) const;
 
     /**
-     * @brief Checks if a path is under attack by opponent pieces
-     * @param row Row of the path
-     * @param startCol Starting column of the path
-     * @param endCol Ending column of the path
-     * @param kingColor Color of the king
-     * @return true if the path is under attack, false otherwise
+     * @brief Appends every legal move of a side
+     * @param color Side whose moves are generated
+     * @param info Check and pin data of that side
+     * @param moves List the legal moves are appended to
+     * @param kind Which of the moves to generate
      */
-    bool isPathUnderAttack(int row, int startCol, int endCol, PieceColor kingColor) const;
+    void generateLegalMoves(PieceColor color, const CheckInfo& info, MoveList& moves, MoveGenType kind = MoveGenType::ALL) const;
+
+    /**
+     * @brief Removes every piece and clears the game state
+     *
+     * Leaves white to move with no castling rights, no en passant
+     * capture and an empty history.
+     */
+    void clearBoard();
 public:
     /**
      * @brief Default constructor, initializes an empty chess board
      */
     ChessBoard();
 
+    /**
+     * @brief Returns the current position as a value
+     *
+     * The result is a plain copy of under 100 bytes that does not change
+     * with the board, so it serves as an O(1) snapshot for setPosition()
+     * or for handing the position to another thread.
+     *
+     * @return Snapshot of the position
+     */
+    Position getPosition() const { return position; }
+
+    /**
+     * @brief Replaces the position with a snapshot taken by getPosition()
+     *
+     * The move history is cleared, since its moves do not lead to the new
+     * position.
+     *
+     * @param snapshot Position to restore
+     */
+    void setPosition(const Position& snapshot);
+
+    /**
+     * @brief Copies the keys of the earlier positions a repetition could still match
+     *
+     * These are the keys of the last halfmove-clock plies of the history,
+     * the only ones getRepetitionCount() looks at, here or in any position
+     * reached from here.
+     *
+     * @param keys Receives the keys, oldest first
+     * @param capacity Room in keys; older keys beyond it are left out
+     * @return Number of keys written
+     */
+    int getRepetitionKeys(std::uint64_t* keys, int capacity) const;
+
+    /**
+     * @brief Replaces the position and the keys repetitions are checked against
+     *
+     * Continues a position taken by getPosition() and getRepetitionKeys()
+     * without copying the move history: moves made afterwards can be
+     * unmade, earlier ones cannot, but repetitions of the earlier
+     * positions are still found.
+     *
+     * @param snapshot Position to restore
+     * @param keys Keys of the earlier positions, oldest first
+     * @param count Number of keys
+     */
+    void setPosition(const Position& snapshot, const std::uint64_t* keys, int count);
+
     /**
      * @brief Resets the board to the initial piece arrangement
      */
     void resetBoard();
 
+    /**
+     * @brief Sets up the position described by a FEN string
+     *
+     * Reads piece placement, side to move, castling rights, the en
+     * passant square and the move clocks; missing clocks count as "0 1".
+     * The move history is cleared.
+     *
+     * @param fen Position in Forsyth-Edwards Notation
+     * @return true if the position was loaded, false if the string is
+     *         malformed (the board is then reset to the initial position)
+     */
+    bool loadFen(const std::string& fen);
+
+    /**
+     * @brief Describes the current position in Forsyth-Edwards Notation
+     *
+     * The fullmove number counts on from the one loaded with loadFen().
+     *
+     * @return FEN string of the position
+     */
+    std::string toFen() const;
+
     /**
      * @brief Returns a const pointer to the piece at the given position
+     *
+     * The board stores piece codes, not piece objects; the returned pointer
+     * refers to a shared, immutable piece of the right type and color. Its
+     * moved flag follows the castling rights: a king or rook reports
+     * false from getHasMoved() only while it can still castle, other
+     * pieces always report false.
+     *
      * @param row Row number
      * @param col Column number
-     * @return Const pointer to the piece or nullptr if the square is empty
+     * @return Const pointer to the piece or to an empty piece if the square is empty
      */
     const Piece* getPieceAt(int row, int col) const;
 
     /**
-     * @brief Returns a pointer to the piece at the given position
+     * @brief Returns the code of the piece at the given position
      * @param row Row number
      * @param col Column number
-     * @return Pointer to the piece or nullptr if the square is empty
+     * @return Piece code, NO_PIECE for an empty square
+     */
+    PieceCode getPieceCode(int row, int col) const { return position.pieceOn(makeSquare(row, col)); }
+
+    /**
+     * @brief Returns the squares occupied by pieces of a type and color
+     * @param type Piece type (NONE for every piece of the color)
+     * @param color Piece color
+     * @return Bitboard of matching squares
+     */
+    Bitboard getPieces(PieceType type, PieceColor color) const;
+
+    /**
+     * @brief Returns every occupied square
+     * @return Occupancy bitboard
      */
-    Piece* getPieceAt(int row, int col);
+    Bitboard getOccupied() const { return position.typeBB[0]; }
+
+    /**
+     * @brief Returns the square of a side's king
+     * @param color WHITE or BLACK
+     * @return Square index or -1 if the side has no king
+     */
+    int getKingSquare(PieceColor color) const { return position.kingSquares[colorIndex(color)]; }
+
+    /**
+     * @brief Creates a standalone piece object
+     * @param type Type of the piece
+     * @param color Color of the piece
+     * @return Newly allocated piece or nullptr for PieceType::NONE
+     */
+    static std::unique_ptr<Piece> createPiece(PieceType type, PieceColor color);
+
 
     /**
      * @brief Places a piece at the given position
+     *
+     * Castling rights that depend on the square are dropped; grant them
+     * again with setCastlingRights() when setting up a position.
+     *
      * @param row Row number
      * @param col Column number
      * @param piece Pointer to the piece to be placed
@@ -187,6 +470,9 @@ public:
 
     /**
      * @brief Removes a piece from the given position and returns it
+     *
+     * Castling rights that depend on the square are dropped.
+     *
      * @param row Row number
      * @param col Column number
      * @return Pointer to the removed piece or nullptr if the square was empty
@@ -194,12 +480,92 @@ public:
     std::unique_ptr<Piece> removePieceAt(int row, int col);
 
     /**
-     * @brief Returns a list of possible moves for the piece at the given position
+     * @brief Returns a list of legal moves for the piece at the given position
+     *
+     * Moves that would leave the own king in check, including castling
+     * out of or through check, are excluded. A pawn move onto the last row
+     * is listed once per promotion piece. Pieces of the side to move are
+     * served from the legal move cache (see getLegalMoves()).
+     *
      * @param row Row number
      * @param col Column number
-     * @return Vector of positions where the piece can move
+     * @param moves List the legal moves are appended to
+     */
+    void getPossibleMoves(int row, int col, MoveList& moves) const;
+
+    /**
+     * @brief Returns every legal move of the side to move
+     *
+     * The moves are generated once per position and kept until the next
+     * change to the board, so repeated queries about the same position
+     * (highlighting, validation, check and mate tests) share one pass.
+     * Because of the cache, const queries on one board must not run
+     * concurrently. A pawn move onto the last row is listed once per
+     * promotion piece.
+     *
+     * @return Legal moves, valid until the board changes
+     */
+    const MoveList& getLegalMoves() const;
+
+    /**
+     * @brief Generates every legal move of the side to move, bypassing the cache
+     *
+     * For search and move-path enumeration, which visit each position once.
+     *
+     * @param moves List the legal moves are appended to
+     * @param kind Which of the moves to generate
      */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col) const;
+    void generateLegalMoves(MoveList& moves, MoveGenType kind = MoveGenType::ALL) const;
+
+    /**
+     * @brief Checks if a move is legal for the side to move
+     *
+     * Generates the moves of the moving piece only, so moves from another
+     * position, such as killer moves or transposition table moves, can be
+     * vetted cheaply.
+     *
+     * @param move Move to check
+     * @return true if the side to move has exactly this move
+     */
+    bool isLegalMove(const Move& move) const;
+
+    /**
+     * @brief Checks if a move of the side to move takes a piece
+     * @param move Legal move of the side to move
+     * @return true for en passant and for moves onto an occupied square
+     */
+    bool isCapture(const Move& move) const {
+        return move.flag() == EN_PASSANT || (position.typeBB[0] & squareBB(move.to())) != 0;
+    }
+
+    /**
+     * @brief Generates the pseudo-legal moves of a piece standing on a square
+     *
+     * Dispatches on the piece type; moves may still leave the own king in
+     * check. Castling is offered while the right is held, the king and rook
+     * are on their home squares and the squares between them are empty.
+     * Promotions are generated queen first, then rook, bishop and knight.
+     *
+     * @param square Square of the piece
+     * @param type Type of the piece
+     * @param color Color of the piece
+     * @param moves List the moves are appended to
+     * @param kind Which of the moves to generate
+     */
+    void generatePieceMoves(int square, PieceType type, PieceColor color, MoveList& moves,
+        MoveGenType kind = MoveGenType::ALL) const;
+
+    /**
+     * @brief Looks up the legal move between two squares
+     * @param fromRow Starting row
+     * @param fromCol Starting column
+     * @param toRow Target row
+     * @param toCol Target column
+     * @param promotion Piece a pawn reaching the last row becomes (ignored for other moves)
+     * @param move Receives the move with its flag when found
+     * @return true if such a legal move exists, false otherwise
+     */
+    bool findMove(int fromRow, int fromCol, int toRow, int toCol, PieceType promotion, Move& move) const;
 
     /**
      * @brief Executes a piece movement
@@ -207,9 +573,38 @@ public:
      * @param fromCol Starting column
      * @param toRow Target row
      * @param toCol Target column
+     * @param promotion Piece a pawn reaching the last row becomes (ignored for other moves)
+     * @return true if the move was executed, false if the move is invalid
+     */
+    bool makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceType promotion = PieceType::QUEEN);
+
+    /**
+     * @brief Executes a move after checking that it is legal
+     * @param move Move to execute, as returned by getPossibleMoves() or findMove()
      * @return true if the move was executed, false if the move is invalid
      */
-    bool makeMove(int fromRow, int fromCol, int toRow, int toCol);
+    bool makeMove(const Move& move);
+
+    /**
+     * @brief Executes a legal move without validating it
+     *
+     * Meant for search and move-path enumeration, where the move is known
+     * to be legal. Taken back with unmakeMove().
+     *
+     * @param move Legal move of the side to move
+     */
+    void makeLegalMove(const Move& move);
+
+    /**
+     * @brief Takes back the last move made with makeMove()
+     *
+     * Restores the moved piece (as a pawn if it was promoted), any
+     * captured piece, castling rights, the en passant state and the
+     * halfmove clock.
+     *
+     * @return true if a move was taken back, false if there was none
+     */
+    bool unmakeMove();
 
     /**
      * @brief Promotes a pawn to another piece type
@@ -219,6 +614,61 @@ public:
      */
     void promotePawn(int row, int col, PieceType newType);
 
+    /**
+     * @brief Computes check, checkmate, stalemate and draw state in one pass
+     *
+     * For the side to move the answer comes from the legal move cache, so
+     * asking after every move costs one move generation per position. The
+     * draw rules add O(1) checks and a repetition scan bounded by the
+     * halfmove clock.
+     *
+     * @param side Side to examine
+     * @return Status of the side
+     */
+    GameStatus evaluateStatus(PieceColor side) const;
+
+    /**
+     * @brief Returns the last move made
+     * @return Last move, Move::none() if none was made since the position was set up
+     */
+    Move getLastMove() const { return history.empty() ? Move::none() : history.back().move; }
+
+    /**
+     * @brief Returns the halfmove clock
+     * @return Plies since the last capture or pawn move
+     */
+    int getHalfmoveClock() const { return position.halfmoveClock; }
+
+    /**
+     * @brief Counts earlier occurrences of the current position
+     *
+     * Only keys since the last capture or pawn move are compared, and only
+     * those with the same side to move, so the scan costs at most
+     * halfmoveClock / 2 comparisons. Positions before the last loadFen(),
+     * setPosition() or clearBoard() are not known.
+     *
+     * @return Number of times the position occurred before (2 means threefold)
+     */
+    int getRepetitionCount() const;
+
+    /**
+     * @brief Checks if the fifty-move rule applies
+     * @return true after 100 plies without a capture or pawn move
+     */
+    bool isFiftyMoveDraw() const { return position.halfmoveClock >= 100; }
+
+    /**
+     * @brief Checks if neither side can possibly mate
+     *
+     * True for king against king, king and one minor piece against king,
+     * and positions where every remaining piece besides the kings is a
+     * bishop on squares of one color. Counts come from the piece sets,
+     * which are kept up to date with every move, so this is O(1).
+     *
+     * @return true if the material left cannot deliver mate
+     */
+    bool hasInsufficientMaterial() const;
+
     /**
      * @brief Checks if there is a checkmate
      * @param isWhiteTurn Whether we're checking for the white player
@@ -233,6 +683,57 @@ public:
      */
     bool isStalemate(bool isWhiteTurn) const;
 
+    /**
+     * @brief Checks if a square is attacked by pieces of a color
+     *
+     * Looks outward from the square with knight, king and pawn patterns
+     * and along the sliding rays, so no moves are generated.
+     *
+     * @param square Square index (see makeSquare())
+     * @param byColor Color of the attacking side
+     * @return true if at least one piece of that color attacks the square
+     */
+    bool isSquareAttacked(int square, PieceColor byColor) const;
+
+    /**
+     * @brief Computes the material outcome of a capture sequence (static exchange evaluation)
+     *
+     * Plays out the captures on the target square of the move, each side
+     * recapturing with its least valuable piece and free to stop when
+     * going on would cost it. Sliders lined up behind the pieces taking
+     * part join in as the square opens up. Pins are ignored. Values are
+     * 100 for a pawn, 320 for a knight, 330 for a bishop, 500 for a rook
+     * and 900 for a queen.
+     *
+     * @param move Capture, promotion or other move of any side; the side is taken from the moving piece
+     * @return Material won by the moving side in centipawns, negative if it loses material
+     */
+    int staticExchange(const Move& move) const;
+
+    /**
+     * @brief Returns the pieces of a side that the opponent can win
+     *
+     * A piece hangs when capturing it with the least valuable attacker
+     * wins material (see staticExchange()). Kings are never included.
+     *
+     * @param color Side whose pieces are examined
+     * @return Bitboard of hanging pieces
+     */
+    Bitboard getHangingPieces(PieceColor color) const;
+
+    /**
+     * @brief Returns every square attacked by pieces of a color
+     *
+     * Builds the whole map at once, with the sliders of the side filled
+     * together (see Attacks::slidingAttacks()), which is cheaper than
+     * asking isSquareAttacked() about many squares. Useful for threat
+     * display and mobility counts.
+     *
+     * @param byColor Color of the attacking side
+     * @return Bitboard of attacked squares, including squares of either color
+     */
+    Bitboard getAttackedSquares(PieceColor byColor) const { return attackedSquares(byColor, position.typeBB[0]); }
+
     /**
      * @brief Checks if the player's king is in check
      * @param isWhitePlayer Whether we're checking for the white player
@@ -244,11 +745,74 @@ public:
      * @brief Returns the column where en passant capture is possible
      * @return Column number or -1 if en passant is unavailable
      */
-    int getEnPassantCol() const { return enPassantCol; };
+    int getEnPassantCol() const { return position.enPassantCol; };
 
     /**
      * @brief Returns the row where en passant capture is possible
      * @return Row number
      */
-    int getEnPassantRow() const { return enPassantRow; };
+    int getEnPassantRow() const { return position.enPassantRow; };
+
+    /**
+     * @brief Returns the castling rights still held
+     * @return Combination of CastlingRight bits
+     */
+    int getCastlingRights() const { return position.castlingRights; }
+
+    /**
+     * @brief Replaces the castling rights
+     *
+     * Used when setting up a position; rights whose king or rook is not on
+     * its home square are ignored by move generation.
+     *
+     * @param rights Combination of CastlingRight bits
+     */
+    void setCastlingRights(int rights);
+
+    /**
+     * @brief Returns the side whose turn it is
+     *
+     * makeMove() hands the turn to the opponent of the piece that moved.
+     *
+     * @return WHITE or BLACK
+     */
+    PieceColor getSideToMove() const { return position.sideToMove; }
+
+    /**
+     * @brief Sets the side whose turn it is, used when setting up a position
+     * @param color WHITE or BLACK
+     */
+    void setSideToMove(PieceColor color);
+
+    /**
+     * @brief Returns the Zobrist key of the current position
+     *
+     * Covers piece placement, side to move, castling rights and a usable
+     * en passant column. Equal positions have equal keys however they
+     * were reached.
+     *
+     * @return 64-bit position key
+     */
+    std::uint64_t getKey() const { return position.key; }
+
+    /**
+     * @brief Returns the middlegame material and piece-square sum
+     *
+     * Kept up to date on every move and undo, like the position key.
+     *
+     * @return Centipawns from white's point of view
+     */
+    int getMiddlegameScore() const { return position.middlegameScore; }
+
+    /**
+     * @brief Returns the endgame material and piece-square sum
+     * @return Centipawns from white's point of view
+     */
+    int getEndgameScore() const { return position.endgameScore; }
+
+    /**
+     * @brief Returns the game phase of the position
+     * @return 0 with only kings and pawns left, up to PieceSquare::MAX_PHASE with every piece on the board
+     */
+    int getPhase() const { return position.phase < PieceSquare::MAX_PHASE ? position.phase : PieceSquare::MAX_PHASE; }
 };
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "Engine.h"
+#include <algorithm>
+#include <cstdlib>
+
+Engine::Engine() : finished(false), running(false), info{ 0, 0, Move::none(), 0, 0.0, 0, 0, 0, 0, 0 } {
+    shared.table = &table;
+    shared.stop.store(false, std::memory_order_relaxed);
+    shared.limits = { MAX_DEPTH, 0 };
+    shared.mode = ParallelMode::LAZY_SMP;
+    setThreads(1);
+}
+
+Engine::~Engine() {
+    stop();
+}
+
+SearchInfo Engine::search(const ChessBoard& position, const SearchLimits& searchLimits) {
+    stop();
+    board = position;
+    shared.limits = searchLimits;
+    shared.stop.store(false, std::memory_order_relaxed);
+    return run();
+}
+
+void Engine::start(const ChessBoard& position, const SearchLimits& searchLimits) {
+    stop();
+    board = position;
+    shared.limits = searchLimits;
+    shared.stop.store(false, std::memory_order_relaxed);
+    finished.store(false, std::memory_order_relaxed);
+    running = true;
+    searchThread = std::thread([this] {
+        run();
+        finished.store(true, std::memory_order_release);
+    });
+}
+
+SearchInfo Engine::takeResult() {
+    if (searchThread.joinable()) {
+        searchThread.join();
+    }
+    running = false;
+    return getInfo();
+}
+
+void Engine::stop() {
+    if (searchThread.joinable()) {
+        shared.stop.store(true, std::memory_order_relaxed);
+        searchThread.join();
+    }
+    running = false;
+}
+
+void Engine::setThreads(int count) {
+    stop();
+    count = std::max(1, std::min(count, static_cast<int>(MAX_THREADS)));
+    workers.clear();
+    shared.workers.clear();
+    for (int i = 0; i < count; i++) {
+        workers.push_back(std::unique_ptr<SearchWorker>(new SearchWorker(shared, i)));
+        shared.workers.push_back(workers.back().get());
+    }
+}
+
+void Engine::setParallelMode(ParallelMode mode) {
+    stop();
+    shared.mode = mode;
+}
+
+void Engine::setHashSize(std::size_t megabytes) {
+    stop();
+    table.resize(megabytes);
+}
+
+void Engine::clearHash() {
+    stop();
+    table.clear();
+}
+
+SearchInfo Engine::getInfo() const {
+    std::lock_guard<std::mutex> lock(infoMutex);
+    return info;
+}
+
+SearchInfo Engine::run() {
+    shared.startTime = std::chrono::steady_clock::now();
+    table.newSearch();
+    for (const std::unique_ptr<SearchWorker>& worker : workers) {
+        worker->prepare(board);
+    }
+    {
+        std::lock_guard<std::mutex> lock(infoMutex);
+        info = { 0, 0, Move::none(), 0, 0.0, 0, 0, 0, 0, 0 };
+    }
+
+    MoveList rootMoves;
+    board.generateLegalMoves(rootMoves);
+    if (rootMoves.empty()) {
+        return getInfo();
+    }
+
+    // Lazy SMP helpers alternate between starting at depth 1 and 2, so at
+    // any time they are spread over two iterations instead of all doing
+    // the main thread's work a second time
+    std::vector<std::thread> helpers;
+    for (std::size_t i = 1; i < workers.size(); i++) {
+        SearchWorker* helper = workers[i].get();
+        if (shared.mode == ParallelMode::YBWC) {
+            helpers.emplace_back([helper] { helper->runStealer(); });
+        }
+        else {
+            int firstDepth = 1 + static_cast<int>(i % 2);
+            helpers.emplace_back([helper, firstDepth] { helper->runHelper(firstDepth); });
+        }
+    }
+
+    SearchWorker& main = *workers[0];
+    const SearchLimits& limits = shared.limits;
+    Move best = Move::none();
+    for (int depth = 1; depth <= limits.maxDepth && depth <= MAX_DEPTH; depth++) {
+        Move iterationBest = Move::none();
+        int score = main.searchRoot(depth, best, iterationBest);
+
+        // An interrupted iteration has not looked at every move; its
+        // result is only used if no iteration finished before it
+        bool stopped = shared.stop.load(std::memory_order_relaxed);
+        if (stopped && !best.isNone()) {
+            break;
+        }
+        best = iterationBest;
+
+        {
+            std::lock_guard<std::mutex> lock(infoMutex);
+            info.depth = depth;
+            info.score = score;
+            info.bestMove = best;
+            recordProgress();
+        }
+
+        if (stopped || std::abs(score) >= MATE_SCORE - depth) {
+            break;
+        }
+        // The next iteration takes several times as long as this one, so
+        // starting it past half the budget would waste the time
+        if (limits.moveTimeMs > 0 && elapsedSeconds() * 2000 >= limits.moveTimeMs) {
+            break;
+        }
+    }
+
+    shared.stop.store(true, std::memory_order_relaxed);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    std::lock_guard<std::mutex> lock(infoMutex);
+    // A helper that finished a deeper iteration has the better move
+    for (const std::unique_ptr<SearchWorker>& worker : workers) {
+        if (worker->getCompletedDepth() > info.depth) {
+            info.depth = worker->getCompletedDepth();
+            info.score = worker->getCompletedScore();
+            info.bestMove = worker->getCompletedMove();
+        }
+    }
+    recordProgress();
+    return info;
+}
+
+void Engine::recordProgress() {
+    info.nodes = 0;
+    info.hashProbes = 0;
+    info.hashHits = 0;
+    info.cutoffs = 0;
+    info.firstMoveCutoffs = 0;
+    for (const std::unique_ptr<SearchWorker>& worker : workers) {
+        info.nodes += worker->getNodes();
+        info.hashProbes += worker->getHashProbes();
+        info.hashHits += worker->getHashHits();
+        info.cutoffs += worker->getCutoffs();
+        info.firstMoveCutoffs += worker->getFirstMoveCutoffs();
+    }
+    info.seconds = elapsedSeconds();
+    info.hashUsage = table.getUsagePermille();
+}
+
+double Engine::elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - shared.startTime).count();
+}
+
+int Engine::evaluate(const ChessBoard& position) {
+    // Both sums are kept by the board; blending them is all that is left
+    int phase = position.getPhase();
+    int score = (position.getMiddlegameScore() * phase +
+        position.getEndgameScore() * (PieceSquare::MAX_PHASE - phase)) / PieceSquare::MAX_PHASE;
+    return position.getSideToMove() == PieceColor::WHITE ? score : -score;
+}
@@ -0,0 +1,261 @@
+/**
+ * @file Engine.h
+ * @brief Computer opponent searching ChessBoard positions
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * The engine runs a negamax alpha-beta search with iterative deepening:
+ * it searches one ply deep, then two, and so on until the time budget or
+ * the depth limit runs out, and plays the best move of the last finished
+ * iteration. Each iteration tries the previous best move first, which
+ * makes the cutoffs of the next one much more effective. Below the last
+ * ply a quiescence search plays out the captures that do not lose
+ * material, so no leaf is scored in the middle of an exchange.
+ *
+ * Results are kept in a transposition table that lives as long as the
+ * engine, so a position met again, in this search or in the next move's,
+ * is not searched twice and its best move is tried first.
+ *
+ * With more than one thread the engine runs Lazy SMP by default: helper
+ * threads run the same iterative deepening on their own copies of the
+ * position, and everything they find reaches the main thread through the
+ * shared table. In YBWC mode the helpers instead steal the younger moves
+ * of the nodes the main thread and the other helpers are searching.
+ *
+ * The search works on its own copy of the board, so it can run on a
+ * background thread (start()) while the game screen keeps drawing and
+ * polls for the result.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ChessBoard.h"
+#include "SearchWorker.h"
+#include "TranspositionTable.h"
+
+/**
+ * @struct SearchInfo
+ * @brief Outcome of the last finished iteration of a search
+ */
+struct SearchInfo {
+    int depth;             ///< Depth of the last finished iteration (0 before the first)
+    int score;             ///< Score of bestMove for the side to move, in centipawns
+    Move bestMove;         ///< Move to play, Move::none() if the side to move has none
+    std::uint64_t nodes;   ///< Positions visited by the whole search, all threads together
+    double seconds;        ///< Time spent so far
+    std::uint64_t hashProbes;  ///< Transposition table lookups
+    std::uint64_t hashHits;    ///< Lookups that found an entry
+    int hashUsage;             ///< Table entries written by this search, per thousand
+    std::uint64_t cutoffs;           ///< Nodes that failed high
+    std::uint64_t firstMoveCutoffs;  ///< Nodes that failed high on the first move searched
+
+    /**
+     * @brief Returns the search speed
+     * @return Nodes per second (0 before any time has passed)
+     */
+    std::uint64_t nodesPerSecond() const {
+        return seconds > 0 ? static_cast<std::uint64_t>(nodes / seconds) : 0;
+    }
+
+    /**
+     * @brief Returns the share of table lookups that found an entry
+     * @return Hit rate between 0 and 1
+     */
+    double hashHitRate() const {
+        return hashProbes > 0 ? static_cast<double>(hashHits) / hashProbes : 0.0;
+    }
+
+    /**
+     * @brief Returns the share of fail-high nodes where the first move was enough
+     *
+     * Measures move ordering: with perfect ordering every cutoff comes
+     * from the first move.
+     *
+     * @return Rate between 0 and 1
+     */
+    double firstMoveCutoffRate() const {
+        return cutoffs > 0 ? static_cast<double>(firstMoveCutoffs) / cutoffs : 0.0;
+    }
+};
+
+/**
+ * @class Engine
+ * @brief Iterative-deepening alpha-beta search with an optional background thread
+ */
+class Engine {
+public:
+    static const int MAX_DEPTH = 64;          ///< Deepest iteration the search runs
+    static const int MATE_SCORE = 30000;      ///< Score of mate at the root; mate in n plies scores MATE_SCORE - n
+    static const int INFINITE_SCORE = 32000;  ///< Bound outside every score
+    static const int MAX_THREADS = 256;       ///< Most threads setThreads() accepts
+
+private:
+    ChessBoard board;                  ///< Root position of the running search
+    TranspositionTable table;          ///< Results kept across searches, shared by every worker
+    SearchShared shared;               ///< Table, stop flag, limits and start time of the running search
+
+    /**
+     * @brief One worker per thread; workers[0] runs on the search thread itself
+     */
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+
+    std::atomic<bool> finished;        ///< Set by the background thread once its search returns
+    std::thread searchThread;          ///< Background search started by start()
+    bool running;                      ///< A background search was started and its result not yet taken
+
+    SearchInfo info;                   ///< Result of the last finished iteration
+    mutable std::mutex infoMutex;      ///< Guards info while a background search updates it
+
+    /**
+     * @brief Runs iterative deepening on the main worker, with the helpers alongside
+     *
+     * The main worker decides when the search ends; the helpers are
+     * stopped and joined before this returns. In YBWC mode only the main
+     * worker iterates, and the helpers live off its split points.
+     *
+     * @return Result of the deepest finished iteration of any worker
+     */
+    SearchInfo run();
+
+    /**
+     * @brief Returns the time spent on the running search
+     * @return Seconds since the search started
+     */
+    double elapsedSeconds() const;
+
+    /**
+     * @brief Copies the counters of every worker into info
+     *
+     * Caller must hold infoMutex.
+     */
+    void recordProgress();
+
+public:
+    /**
+     * @brief Constructor
+     */
+    Engine();
+
+    /**
+     * @brief Destructor, stops a running background search
+     */
+    ~Engine();
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    /**
+     * @brief Searches a position on the calling thread
+     * @param position Position to search; left unchanged
+     * @param searchLimits When to stop
+     * @return Result of the last finished iteration
+     */
+    SearchInfo search(const ChessBoard& position, const SearchLimits& searchLimits);
+
+    /**
+     * @brief Starts searching a position on a background thread
+     *
+     * The board is copied, so the caller may keep using it. A search that
+     * is still running is stopped first.
+     *
+     * @param position Position to search
+     * @param searchLimits When to stop
+     */
+    void start(const ChessBoard& position, const SearchLimits& searchLimits);
+
+    /**
+     * @brief Checks if a background search was started and its result not yet taken
+     * @return true between start() and takeResult() or stop()
+     */
+    bool isRunning() const { return running; }
+
+    /**
+     * @brief Checks if the background search has finished
+     * @return true once takeResult() will return without waiting
+     */
+    bool isFinished() const { return finished.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Waits for the background search and returns its result
+     * @return Result of the last finished iteration
+     */
+    SearchInfo takeResult();
+
+    /**
+     * @brief Aborts the background search and discards its result
+     */
+    void stop();
+
+    /**
+     * @brief Resizes the transposition table, dropping its entries
+     *
+     * Stops a running background search first.
+     *
+     * @param megabytes Table size in megabytes
+     */
+    void setHashSize(std::size_t megabytes);
+
+    /**
+     * @brief Sets the number of search threads
+     *
+     * Stops a running background search first.
+     *
+     * @param count Threads including the main one (1 to MAX_THREADS)
+     */
+    void setThreads(int count);
+
+    /**
+     * @brief Returns the number of search threads
+     * @return Threads including the main one
+     */
+    int getThreads() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * @brief Sets how the threads divide the work
+     *
+     * Stops a running background search first.
+     *
+     * @param mode Lazy SMP or YBWC
+     */
+    void setParallelMode(ParallelMode mode);
+
+    /**
+     * @brief Returns how the threads divide the work
+     * @return Current mode
+     */
+    ParallelMode getParallelMode() const { return shared.mode; }
+
+    /**
+     * @brief Empties the transposition table, e.g. for a new game
+     *
+     * Stops a running background search first.
+     */
+    void clearHash();
+
+    /**
+     * @brief Returns the progress of the current or last search
+     *
+     * Safe to call while a background search runs.
+     *
+     * @return Result of the last finished iteration
+     */
+    SearchInfo getInfo() const;
+
+    /**
+     * @brief Scores a position statically
+     *
+     * Material plus piece-square bonuses that pull pieces toward the
+     * centre and pawns up the board, tapered between middlegame and
+     * endgame values by the material left. The board keeps the sums up to
+     * date as moves are made, so this costs a few arithmetic operations.
+     *
+     * @param position Position to score
+     * @return Score in centipawns for the side to move
+     */
+    static int evaluate(const ChessBoard& position);
+};
@@ -1,10 +1,4 @@
 #include "GameScreen.h"
-#include "Pawn.h"
-#include "Rook.h"
-#include "Knight.h"
-#include "Bishop.h"
-#include "Queen.h"
-#include "King.h"
 
 GameScreen::GameScreen(sf::RenderWindow& win, ApplicationManager* manager) : Screen(win),
 boardView(win, chessBoard),
@@ -22,7 +16,9 @@ showPopup(false),
 popupOkButton(0, 0, 100, 40, "OK", 18),
 appManager(manager),
 promotionPopup(win, font, boardView),
-promotionSquare(-1, -1) {
+promotionSquare(-1, -1),
+againstComputer(false),
+computerMoveSeconds(3) {
 
 
     font.loadFromFile("resources/fonts/arial.ttf");
@@ -31,6 +27,15 @@ promotionSquare(-1, -1) {
     popupText.setCharacterSize(24);
     popupText.setFillColor(sf::Color::White);
 
+    engineInfoText.setFont(font);
+    engineInfoText.setCharacterSize(16);
+    engineInfoText.setFillColor(sf::Color::White);
+    engineInfoText.setPosition(boardView.getBoardWidth() + 100, 610);
+
+    // hardware_concurrency() is 0 when the core count is unknown
+    unsigned int cores = std::thread::hardware_concurrency();
+    engine.setThreads(cores > 0 ? static_cast<int>(cores) : 1);
+
     sf::Color buttonColor(50, 80, 150);
     sf::Color hoverColor(100, 160, 255);
 
@@ -76,7 +81,9 @@ void GameScreen::onEnter() {
     updateBackgroundSize();
 }
 
-void GameScreen::onExit() {}
+void GameScreen::onExit() {
+    engine.stop();
+}
 
 std::string GameScreen::handleEvent(const sf::Event& event) {
 
@@ -103,44 +110,7 @@ std::string GameScreen::handleEvent(const sf::Event& event) {
         PieceType chosenType = promotionPopup.handleEvent(event);
 
         if (chosenType != PieceType::NONE) {
-
-            int fromRow = lastMoveFromRow;
-            int fromCol = lastMoveFromCol;
-            int toRow = promotionSquare.x;
-            int toCol = promotionSquare.y;
-
-            chessBoard.promotePawn(toRow, toCol, chosenType);
-
-
-            std::string moveNotation = generatePromotionNotation(fromRow, fromCol, toRow, toCol, chosenType);
-
-            currentPlayer = !currentPlayer;
-            bool isCheck = chessBoard.isInCheck(currentPlayer);
-            bool isCheckmate = chessBoard.isCheckmate(currentPlayer);
-            currentPlayer = !currentPlayer;
-
-            ChessMove move(moveNotation, !currentPlayer, isCheck, isCheckmate,
-                capturedPieceInfo.capturedType, capturedPieceInfo.capturedColor, true);
-
-            move.setSourceCoords(fromRow, fromCol);
-            move.setDestCoords(toRow, toCol);
-
-            historyPanel.addMove(move);
-
-            isPieceSelected = false;
-            boardView.clearHighlights();
-
-            if (currentPlayer) {
-                whiteTimer.stop();
-                blackTimer.start();
-            }
-            else {
-                blackTimer.stop();
-                whiteTimer.start();
-            }
-
-            currentPlayer = !currentPlayer;
-            checkGameState();
+            makeMove(lastMoveFromRow, lastMoveFromCol, promotionSquare.x, promotionSquare.y, chosenType);
         }
 
         return "";
@@ -164,7 +134,7 @@ std::string GameScreen::handleEvent(const sf::Event& event) {
                 return "";
             }
 
-            if (!gameOver) {
+            if (!gameOver && !(againstComputer && !currentPlayer)) {
                 handleBoardClick(mousePos);
             }
         }
@@ -211,6 +181,10 @@ void GameScreen::update() {
             }
         }
     }
+
+    if (againstComputer) {
+        updateComputerMove();
+    }
 }
 
 void GameScreen::render() {
@@ -226,6 +200,10 @@ void GameScreen::render() {
 
     historyPanel.render();
 
+    if (againstComputer) {
+        window.draw(engineInfoText);
+    }
+
     if (showPopup) {
         window.draw(popupBackground);
         window.draw(popupText);
@@ -242,6 +220,7 @@ void GameScreen::render() {
 }
 
 void GameScreen::resetGame() {
+    engine.clearHash();
     chessBoard.resetBoard();
 
     isPieceSelected = false;
@@ -257,6 +236,7 @@ void GameScreen::resetGame() {
 
     historyPanel.clear();
     boardView.clearHighlights();
+    updateHangingPieces();
 }
 
 void GameScreen::handleBoardClick(const sf::Vector2i& mousePos) {
@@ -281,7 +261,8 @@ void GameScreen::handleBoardClick(const sf::Vector2i& mousePos) {
             selectedPiecePos = boardPos;
             boardView.highlightSelectedPiece(boardPos.x, boardPos.y);
 
-            auto moves = chessBoard.getPossibleMoves(boardPos.x, boardPos.y);
+            MoveList moves;
+            chessBoard.getPossibleMoves(boardPos.x, boardPos.y, moves);
             boardView.setPossibleMoves(moves);
         }
     }
@@ -294,172 +275,84 @@ void GameScreen::handleBoardClick(const sf::Vector2i& mousePos) {
             selectedPiecePos = boardPos;
             boardView.highlightSelectedPiece(boardPos.x, boardPos.y);
 
-            auto moves = chessBoard.getPossibleMoves(boardPos.x, boardPos.y);
+            MoveList moves;
+            chessBoard.getPossibleMoves(boardPos.x, boardPos.y, moves);
             boardView.setPossibleMoves(moves);
         }
         else {
-            auto moves = chessBoard.getPossibleMoves(selectedPiecePos.x, selectedPiecePos.y);
-            bool validMove = false;
-
-            for (const auto& move : moves) {
-                if (move.x == boardPos.x && move.y == boardPos.y) {
-                    validMove = true;
-                    break;
-                }
-            }
+            MoveList moves;
+            chessBoard.getPossibleMoves(selectedPiecePos.x, selectedPiecePos.y, moves);
 
-            if (validMove) {
+            if (moves.contains(makeSquare(selectedPiecePos.x, selectedPiecePos.y), makeSquare(boardPos.x, boardPos.y))) {
                 makeMove(selectedPiecePos.x, selectedPiecePos.y, boardPos.x, boardPos.y);
             }
         }
     }
 }
 
-void GameScreen::makeMove(int fromRow, int fromCol, int toRow, int toCol) {
-    lastMoveFromRow = fromRow;
-    lastMoveFromCol = fromCol;
-
-    const Piece* targetPiece = chessBoard.getPieceAt(toRow, toCol);
-    capturedPieceInfo.capturedType = PieceType::NONE;
-    capturedPieceInfo.capturedColor = PieceColor::NONE;
-    bool wasPromotion = false;
-
-    bool isEnPassantCapture = false;
-    int enPassantCapturedRow = -1;
-    int enPassantCapturedCol = -1;
-
-    bool isCastling = false;
-    bool isKingsideCastling = false;
-    int rookFromCol = -1;
-    int rookToCol = -1;
-
-    Piece* piece = chessBoard.getPieceAt(fromRow, fromCol);
-    if (piece && piece->getType() == PieceType::KING && abs(fromCol - toCol) == 2) {
-        isCastling = true;
-        isKingsideCastling = (toCol > fromCol);
-
-        if (isKingsideCastling) {
-            rookFromCol = 7;
-            rookToCol = 5;
-        }
-        else {
-            rookFromCol = 0;
-            rookToCol = 3;
-        }
+void GameScreen::makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceType promotion) {
+    Move move;
+    PieceType probe = (promotion == PieceType::NONE) ? PieceType::QUEEN : promotion;
+    if (!chessBoard.findMove(fromRow, fromCol, toRow, toCol, probe, move)) {
+        return;
     }
 
-    if (piece && piece->getType() == PieceType::PAWN) {
-        bool isWhitePawn = piece->isWhite();
+    lastMoveFromRow = fromRow;
+    lastMoveFromCol = fromCol;
 
-        if (isWhitePawn && fromRow == 3 && abs(fromCol - toCol) == 1 && toRow == 2 &&
-            toCol == chessBoard.getEnPassantCol()) {
-            isEnPassantCapture = true;
-            enPassantCapturedRow = 3;
-            enPassantCapturedCol = toCol;
+    // The move is made once the player has picked the promotion piece
+    if (move.isPromotion() && promotion == PieceType::NONE) {
+        promotionSquare.x = toRow;
+        promotionSquare.y = toCol;
 
-            const Piece* capturedPawn = chessBoard.getPieceAt(enPassantCapturedRow, enPassantCapturedCol);
-            if (capturedPawn) {
-                capturedPieceInfo.capturedType = capturedPawn->getType();
-                capturedPieceInfo.capturedColor = capturedPawn->getColor();
-            }
-        }
-        else if (!isWhitePawn && fromRow == 4 && abs(fromCol - toCol) == 1 && toRow == 5 &&
-            toCol == chessBoard.getEnPassantCol()) {
-            isEnPassantCapture = true;
-            enPassantCapturedRow = 4;
-            enPassantCapturedCol = toCol;
-
-            const Piece* capturedPawn = chessBoard.getPieceAt(enPassantCapturedRow, enPassantCapturedCol);
-            if (capturedPawn) {
-                capturedPieceInfo.capturedType = capturedPawn->getType();
-                capturedPieceInfo.capturedColor = capturedPawn->getColor();
-            }
-        }
+        bool isWhitePiece = chessBoard.getPieceAt(fromRow, fromCol)->isWhite();
+        promotionPopup.show(isWhitePiece);
+        return;
     }
 
-    if (!isEnPassantCapture && targetPiece && !targetPiece->isEmpty()) {
+    int capturedRow = (move.flag() == EN_PASSANT) ? fromRow : toRow;
+    const Piece* targetPiece = chessBoard.getPieceAt(capturedRow, toCol);
+    capturedPieceInfo.capturedType = PieceType::NONE;
+    capturedPieceInfo.capturedColor = PieceColor::NONE;
+    if (targetPiece && !targetPiece->isEmpty()) {
         capturedPieceInfo.capturedType = targetPiece->getType();
         capturedPieceInfo.capturedColor = targetPiece->getColor();
     }
 
-    bool success = chessBoard.makeMove(fromRow, fromCol, toRow, toCol);
-
-    if (success) {
-        std::string moveNotation;
-        if (isCastling) {
-            if (isKingsideCastling) {
-                moveNotation = "O-O";
-            }
-            else {
-                moveNotation = "O-O-O";
-            }
-        }
-        else {
-            moveNotation = generateMoveNotation(fromRow, fromCol, toRow, toCol);
-        }
-
-        currentPlayer = !currentPlayer;
-
-        bool isCheck = chessBoard.isInCheck(currentPlayer);
-        bool isCheckmate = chessBoard.isCheckmate(currentPlayer);
-
-        currentPlayer = !currentPlayer;
-
-        if (needsPromotion(toRow, toCol)) {
-            promotionSquare.x = toRow;
-            promotionSquare.y = toCol;
-
-            wasPromotion = true;
-
-            bool isWhitePiece = chessBoard.getPieceAt(toRow, toCol)->isWhite();
-            promotionPopup.show(isWhitePiece);
-
-            return;
-        }
-        else {
-            isPieceSelected = false;
-            boardView.clearHighlights();
-
-            if (currentPlayer) {
-                whiteTimer.stop();
-                blackTimer.start();
-            }
-            else {
-                blackTimer.stop();
-                whiteTimer.start();
-            }
-
-            currentPlayer = !currentPlayer;
-            ChessMove move(moveNotation, currentPlayer, isCheck, isCheckmate,
-                capturedPieceInfo.capturedType, capturedPieceInfo.capturedColor, wasPromotion);
+    if (!chessBoard.makeMove(move)) {
+        return;
+    }
 
-            move.setSourceCoords(fromRow, fromCol);
-            move.setDestCoords(toRow, toCol);
+    std::string moveNotation;
+    if (move.flag() == CASTLING) {
+        moveNotation = (toCol > fromCol) ? "O-O" : "O-O-O";
+    }
+    else if (move.isPromotion()) {
+        moveNotation = generatePromotionNotation(fromRow, fromCol, toRow, toCol, move.promotionType());
+    }
+    else {
+        moveNotation = generateMoveNotation(fromRow, fromCol, toRow, toCol);
+    }
 
-            if (isEnPassantCapture) {
-                move.setEnPassantCapture(true, enPassantCapturedRow, enPassantCapturedCol);
-            }
+    GameStatus status = chessBoard.evaluateStatus(currentPlayer ? PieceColor::BLACK : PieceColor::WHITE);
 
-            if (isCastling) {
-                move.setCastling(isKingsideCastling, rookFromCol, rookToCol);
-            }
+    isPieceSelected = false;
+    boardView.clearHighlights();
+    updateHangingPieces();
 
-            historyPanel.addMove(move);
-            checkGameState();
-        }
+    if (currentPlayer) {
+        whiteTimer.stop();
+        blackTimer.start();
     }
-}
-
-bool GameScreen::needsPromotion(int row, int col) {
-    const Piece* piece = chessBoard.getPieceAt(row, col);
-
-    if (piece && piece->getType() == PieceType::PAWN) {
-        if ((piece->isWhite() && row == 0) || (piece->isBlack() && row == 7)) {
-            return true;
-        }
+    else {
+        blackTimer.stop();
+        whiteTimer.start();
     }
 
-    return false;
+    currentPlayer = !currentPlayer;
+    historyPanel.addMove(ChessMove::fromMove(move, moveNotation, currentPlayer, status.inCheck, status.checkmate,
+        capturedPieceInfo.capturedType, capturedPieceInfo.capturedColor));
+    checkGameState(status);
 }
 
 std::string GameScreen::generateMoveNotation(int fromRow, int fromCol, int toRow, int toCol) {
@@ -528,8 +421,8 @@ std::string GameScreen::generatePromotionNotation(int fromRow, int fromCol, int
 }
 
 
-void GameScreen::checkGameState() {
-    if (chessBoard.isCheckmate(currentPlayer)) {
+void GameScreen::checkGameState(const GameStatus& status) {
+    if (status.checkmate) {
         gameOver = true;
         whiteTimer.stop();
         blackTimer.stop();
@@ -537,16 +430,21 @@ void GameScreen::checkGameState() {
         sf::Color color = currentPlayer ? sf::Color::Black : sf::Color::White;
         showPopupWin(message, color);
     }
-    else if (chessBoard.isStalemate(currentPlayer)) {
+    else if (status.isDraw()) {
         gameOver = true;
         whiteTimer.stop();
         blackTimer.stop();
-        std::string message = "Stalemate! Draw!";
+        std::string message;
+        switch (status.drawReason) {
+        case DrawReason::STALEMATE: message = "Stalemate! Draw!"; break;
+        case DrawReason::INSUFFICIENT_MATERIAL: message = "Insufficient material! Draw!"; break;
+        case DrawReason::FIFTY_MOVE_RULE: message = "Fifty-move rule! Draw!"; break;
+        case DrawReason::THREEFOLD_REPETITION: message = "Threefold repetition! Draw!"; break;
+        default: message = "Draw!"; break;
+        }
         sf::Color color = sf::Color(150, 150, 150);
         showPopupWin(message, color);
     }
-    else if (chessBoard.isInCheck(currentPlayer)) {
-    }
 }
 
 void GameScreen::undoLastMove() {
@@ -554,177 +452,9 @@ void GameScreen::undoLastMove() {
         return;
     }
 
-    const ChessMove& lastMove = historyPanel.getLastMove();
-    bool wasPromotion = lastMove.getWasPromotion();
-    bool wasEnPassant = lastMove.getWasEnPassant();
-    bool wasCastling = lastMove.getWasCastling();
-
-    if (wasCastling) {
-        int kingRow = lastMove.sourceRow;
-        int kingFromCol = lastMove.sourceCol;
-        int kingToCol = lastMove.destCol;
-
-        int rookRow = kingRow;
-        int rookFromCol = lastMove.getRookFromCol();
-        int rookToCol = lastMove.getRookToCol();
-
-        std::unique_ptr<Piece> king = chessBoard.removePieceAt(kingRow, kingToCol);
-        std::unique_ptr<Piece> rook = chessBoard.removePieceAt(rookRow, rookToCol);
-
-        if (king) king->setHasMoved(false);
-        if (rook) rook->setHasMoved(false);
-
-        chessBoard.setPieceAt(kingRow, kingFromCol, std::move(king));
-        chessBoard.setPieceAt(rookRow, rookFromCol, std::move(rook));
-    }
-    else if (wasEnPassant) {
-
-        int fromRow = lastMove.sourceRow;
-        int fromCol = lastMove.sourceCol;
-        int toRow = lastMove.destRow;
-        int toCol = lastMove.destCol;
-
-        int capturedRow = lastMove.enPassantCapturedRow;
-        int capturedCol = lastMove.enPassantCapturedCol;
-
-        std::unique_ptr<Piece> movingPawn = chessBoard.removePieceAt(toRow, toCol);
-
-        chessBoard.setPieceAt(fromRow, fromCol, std::move(movingPawn));
-
-        PieceColor capturedColor = currentPlayer ? PieceColor::WHITE : PieceColor::BLACK;
-        std::unique_ptr<Piece> capturedPawn = std::make_unique<Pawn>(capturedColor);
-        chessBoard.setPieceAt(capturedRow, capturedCol, std::move(capturedPawn));
-    }
-    else if (wasPromotion) {
-
-        int fromRow = lastMove.sourceRow;
-        int fromCol = lastMove.sourceCol;
-        int toRow = lastMove.destRow;
-        int toCol = lastMove.destCol;
-
-        if (fromRow == -1 || toRow == -1) {
-            std::string notation = lastMove.notation;
-
-            size_t equalPos = notation.find('=');
-            if (equalPos != std::string::npos && equalPos >= 2) {
-                char destFile = notation[equalPos - 2];
-                char destRank = notation[equalPos - 1];
-                toCol = destFile - 'a';
-                toRow = '8' - destRank;
-
-                char sourceFile = notation[0];
-                fromCol = sourceFile - 'a';
-
-                if (toRow == 0) {
-                    fromRow = 1;
-                }
-                else if (toRow == 7) {
-                    fromRow = 6;
-                }
-            }
-        }
-
-        std::unique_ptr<Piece> promotedPiece = chessBoard.removePieceAt(toRow, toCol);
-
-        std::unique_ptr<Piece> pawn = std::make_unique<Pawn>(currentPlayer ? PieceColor::BLACK : PieceColor::WHITE);
-        chessBoard.setPieceAt(fromRow, fromCol, std::move(pawn));
-
-        if (lastMove.getWasPieceCaptured()) {
-            std::unique_ptr<Piece> capturedPiece = nullptr;
-
-            switch (lastMove.getCapturedPieceType()) {
-            case PieceType::PAWN:
-                capturedPiece = std::make_unique<Pawn>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::ROOK:
-                capturedPiece = std::make_unique<Rook>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::KNIGHT:
-                capturedPiece = std::make_unique<Knight>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::BISHOP:
-                capturedPiece = std::make_unique<Bishop>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::QUEEN:
-                capturedPiece = std::make_unique<Queen>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::KING:
-                capturedPiece = std::make_unique<King>(lastMove.getCapturedPieceColor());
-                break;
-            default:
-                break;
-            }
-
-            if (capturedPiece) {
-                chessBoard.setPieceAt(toRow, toCol, std::move(capturedPiece));
-            }
-        }
-    }
-    else {
-        std::string notation = lastMove.notation;
-        int startIndex = 0;
-        if (notation[0] >= 'A' && notation[0] <= 'Z') {
-            startIndex = 1;
-        }
-
-        char fromFile = notation[startIndex];
-        char fromRank = notation[startIndex + 1];
-
-        int toIndex = notation.find('-');
-        if (toIndex == std::string::npos) {
-            toIndex = notation.find('x');
-        }
-
-        if (toIndex == std::string::npos) {
-            return;
-        }
-
-        toIndex += 1;
-        char toFile = notation[toIndex];
-        char toRank = notation[toIndex + 1];
-
-        int fromCol = fromFile - 'a';
-        int fromRow = '8' - fromRank;
-        int toCol = toFile - 'a';
-        int toRow = '8' - toRank;
-
-        std::unique_ptr<Piece> movedPiece = chessBoard.removePieceAt(toRow, toCol);
-        if (!movedPiece) {
-            return;
-        }
-
-        chessBoard.setPieceAt(fromRow, fromCol, std::move(movedPiece));
-
-        if (lastMove.getWasPieceCaptured()) {
-            std::unique_ptr<Piece> capturedPiece = nullptr;
-
-            switch (lastMove.getCapturedPieceType()) {
-            case PieceType::PAWN:
-                capturedPiece = std::make_unique<Pawn>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::ROOK:
-                capturedPiece = std::make_unique<Rook>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::KNIGHT:
-                capturedPiece = std::make_unique<Knight>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::BISHOP:
-                capturedPiece = std::make_unique<Bishop>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::QUEEN:
-                capturedPiece = std::make_unique<Queen>(lastMove.getCapturedPieceColor());
-                break;
-            case PieceType::KING:
-                capturedPiece = std::make_unique<King>(lastMove.getCapturedPieceColor());
-                break;
-            default:
-                break;
-            }
-
-            if (capturedPiece) {
-                chessBoard.setPieceAt(toRow, toCol, std::move(capturedPiece));
-            }
-        }
+    engine.stop();
+    if (!chessBoard.unmakeMove()) {
+        return;
     }
 
     historyPanel.removeLastMove();
@@ -741,7 +471,51 @@ void GameScreen::undoLastMove() {
 
     isPieceSelected = false;
     boardView.clearHighlights();
+    updateHangingPieces();
+
+    if (againstComputer && !currentPlayer) {
+        undoLastMove();
+    }
+}
+
+void GameScreen::updateComputerMove() {
+    if (gameOver || showPopup || currentPlayer) {
+        return;
+    }
 
+    if (!engine.isRunning()) {
+        engine.start(chessBoard, { Engine::MAX_DEPTH, computerMoveSeconds * 1000 });
+        return;
+    }
+    if (!engine.isFinished()) {
+        return;
+    }
+
+    SearchInfo result = engine.takeResult();
+    engineInfoText.setString("Depth " + std::to_string(result.depth) +
+        "\nNodes " + std::to_string(result.nodes) +
+        "\n" + std::to_string(result.nodesPerSecond() / 1000) + " kN/s" +
+        "\nHash hits " + std::to_string(static_cast<int>(result.hashHitRate() * 100 + 0.5)) + "%");
+
+    Move move = result.bestMove;
+    if (!move.isNone()) {
+        makeMove(rowOf(move.from()), colOf(move.from()), rowOf(move.to()), colOf(move.to()),
+            move.isPromotion() ? move.promotionType() : PieceType::QUEEN);
+    }
+}
+
+void GameScreen::updateHangingPieces() {
+    boardView.setHangingPieces(againstComputer ? chessBoard.getHangingPieces(PieceColor::WHITE) : 0);
+}
+
+void GameScreen::setComputerOpponent(bool enabled, int moveSeconds) {
+    engine.stop();
+    computerMoveSeconds = moveSeconds;
+    if (enabled != againstComputer) {
+        againstComputer = enabled;
+        engineInfoText.setString("");
+        resetGame();
+    }
 }
 
 void GameScreen::updateBackgroundSize() {
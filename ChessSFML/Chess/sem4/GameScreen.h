@@ -15,6 +15,7 @@
 #include "MoveHistoryPanel.h"
 #include "ChessBoard.h"
 #include "BoardView.h"
+#include "Engine.h"
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
@@ -29,6 +30,7 @@
   * - Handling player interactions
   * - Managing game state
   * - Tracking move history and game progression
+  * - Letting the computer play black when selected from the menu
   */
 class GameScreen : public Screen {
 private:
@@ -82,6 +84,12 @@ private:
     std::string popupMessage;  ///< Message to display in popup
     sf::Color popupColor;  ///< Color of the popup
 
+    // Computer opponent
+    Engine engine;               ///< Search that picks the computer's moves
+    bool againstComputer;        ///< Flag indicating if the computer plays black
+    int computerMoveSeconds;     ///< Thinking time of the computer per move
+    sf::Text engineInfoText;     ///< Depth, nodes, speed and hash hit rate of the computer's last search
+
     /**
      * @brief Handles click events on the chess board
      * @param mousePos Position of the mouse click
@@ -90,20 +98,17 @@ private:
 
     /**
      * @brief Executes a move on the chess board
+     *
+     * A promotion without a chosen piece opens the promotion popup
+     * instead; the move is made once a piece is picked.
+     *
      * @param fromRow Source row of the piece
      * @param fromCol Source column of the piece
      * @param toRow Destination row
      * @param toCol Destination column
+     * @param promotion Piece a promoting pawn becomes, NONE to ask the player
      */
-    void makeMove(int fromRow, int fromCol, int toRow, int toCol);
-
-    /**
-     * @brief Checks if a piece needs promotion
-     * @param row Row of the piece
-     * @param col Column of the piece
-     * @return bool True if promotion is needed, false otherwise
-     */
-    bool needsPromotion(int row, int col);
+    void makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceType promotion = PieceType::NONE);
 
     /**
      * @brief Generates algebraic notation for a move
@@ -127,15 +132,37 @@ private:
     std::string generatePromotionNotation(int fromRow, int fromCol, int toRow, int toCol, PieceType promotedTo);
 
     /**
-     * @brief Checks and updates the current game state
+     * @brief Ends the game when the player to move is mated or drawn
+     * @param status Status of the player to move, from ChessBoard::evaluateStatus()
      */
-    void checkGameState();
+    void checkGameState(const GameStatus& status);
 
     /**
      * @brief Undoes the last move
+     *
+     * Against the computer the player's last move is taken back together
+     * with the computer's reply, so the player is to move again.
      */
     void undoLastMove();
 
+    /**
+     * @brief Drives the computer's turn, called every frame
+     *
+     * Starts a background search when the computer is to move and plays
+     * its move once the search is done, so the window keeps responding
+     * while the computer thinks.
+     */
+    void updateComputerMove();
+
+    /**
+     * @brief Outlines the player's pieces the computer can win by capturing
+     *
+     * Shown only against the computer, where it warns the player; in a
+     * game between two people it would hand out hints. Called whenever
+     * the position changes.
+     */
+    void updateHangingPieces();
+
     /**
      * @brief Updates the background size based on window dimensions
      */
@@ -203,4 +230,14 @@ public:
      * @param blackTime Initial time for black player in seconds
      */
     void setPlayerTimes(int whiteTime, int blackTime);
+
+    /**
+     * @brief Selects whether the computer plays black
+     *
+     * Switching between the modes starts a new game.
+     *
+     * @param enabled True to play against the computer
+     * @param moveSeconds Thinking time of the computer per move in seconds
+     */
+    void setComputerOpponent(bool enabled, int moveSeconds);
 };
\ No newline at end of file
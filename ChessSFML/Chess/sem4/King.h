@@ -6,8 +6,6 @@
  */
 
 #pragma once
-#include <vector>
-#include <SFML/System/Vector2.hpp>
 #include "Piece.h"
 
 class ChessBoard;
@@ -27,17 +25,4 @@ public:
      * @param color The color of the king (WHITE or BLACK)
      */
     King(PieceColor color);
-
-    /**
-     * @brief Gets all possible moves for this king
-     * @param row Current row position of the king
-     * @param col Current column position of the king
-     * @param board Reference to the chess board
-     * @return Vector of possible destination coordinates
-     *
-     * Calculates all valid moves for the king from the current position,
-     * including one square in any direction and castling moves if available.
-     * Squares under attack by opponent pieces are excluded from the results.
-     */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const override;
 };
\ No newline at end of file
@@ -6,8 +6,6 @@
  */
 
 #pragma once
-#include <vector>
-#include <SFML/System/Vector2.hpp>
 #include "Piece.h"
 
 class ChessBoard;
@@ -27,17 +25,4 @@ public:
      * @param color The color of the knight (WHITE or BLACK)
      */
     Knight(PieceColor color);
-
-    /**
-     * @brief Gets all possible moves for this knight
-     * @param row Current row position of the knight
-     * @param col Current column position of the knight
-     * @param board Reference to the chess board
-     * @return Vector of possible destination coordinates
-     *
-     * Calculates all valid L-shaped moves for the knight from the current position.
-     * The knight can jump over other pieces, so only the destination square needs
-     * to be checked for availability (empty or occupied by an opponent's piece).
-     */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const override;
 };
\ No newline at end of file
@@ -3,8 +3,9 @@
 MenuScreen::MenuScreen(sf::RenderWindow& win) :
     Screen(win),
     playButton(200, 200, 180, 40, "Play"),
-    optionsButton(200, 260, 180, 40, "Options"),
-    exitButton(200, 320, 180, 40, "Exit")
+    computerButton(200, 260, 180, 40, "Play vs Computer"),
+    optionsButton(200, 320, 180, 40, "Options"),
+    exitButton(200, 380, 180, 40, "Exit")
 {
     if (!backgroundTexture.loadFromFile("resources/images/menu_background.png")) {
         sf::Image fallbackImage;
@@ -17,6 +18,7 @@ MenuScreen::MenuScreen(sf::RenderWindow& win) :
     sf::Color hoverColor(130, 130, 220);
 
     playButton.setColors(buttonColor, hoverColor);
+    computerButton.setColors(buttonColor, hoverColor);
     optionsButton.setColors(buttonColor, hoverColor);
     exitButton.setColors(buttonColor, hoverColor);
 
@@ -36,6 +38,7 @@ void MenuScreen::render() {
 
     window.draw(backgroundSprite);
     playButton.render(window);
+    computerButton.render(window);
     optionsButton.render(window);
     exitButton.render(window);
 }
@@ -53,6 +56,9 @@ std::string MenuScreen::handleEvent(const sf::Event& event) {
         if (playButton.isClicked(mousePos)) {
             return "game";
         }
+        else if (computerButton.isClicked(mousePos)) {
+            return "computer";
+        }
         else if (optionsButton.isClicked(mousePos)) {
             return "options";
         }
@@ -68,6 +74,7 @@ void MenuScreen::update() {
     sf::Vector2i mousePos = sf::Mouse::getPosition(window);
 
     playButton.update(mousePos);
+    computerButton.update(mousePos);
     optionsButton.update(mousePos);
     exitButton.update(mousePos);
 }
\ No newline at end of file
@@ -17,12 +17,14 @@
   *
   * Manages the initial screen with options to:
   * - Start a new game
+  * - Start a game against the computer
   * - Access options
   * - Exit the application
   */
 class MenuScreen : public Screen {
 private:
     Button playButton;        ///< Button to start a new game
+    Button computerButton;    ///< Button to start a game against the computer
     Button optionsButton;     ///< Button to access game options
     Button exitButton;        ///< Button to exit the application
 
@@ -35,7 +37,7 @@ public:
      * @param win Reference to the application's render window
      *
      * Initializes menu buttons and background:
-     * - Creates buttons for play, options, and exit
+     * - Creates buttons for play, play vs computer, options, and exit
      * - Loads background image or creates a fallback
      * - Sets button colors
      * - Configures initial window size
@@ -75,6 +77,7 @@ public:
      *
      * Processes mouse clicks on menu buttons:
      * - Play button starts a new game
+     * - Play vs Computer button starts a game against the computer
      * - Options button opens options screen
      * - Exit button closes the application
      */
@@ -0,0 +1,216 @@
+/**
+ * @file Move.h
+ * @brief Move representation and a fixed-capacity move list
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * A move packs into 16 bits: source and target square, the promotion
+ * piece and a flag for the special moves, so the board never has to work
+ * out what kind of move it is handed. Move generation writes into a
+ * MoveList that lives on the caller's stack, so generating, filtering and
+ * testing moves never touches the heap.
+ */
+
+#pragma once
+#include <cstdint>
+#include "PieceCode.h"
+
+/**
+ * @enum MoveFlag
+ * @brief Kind of move, stored in the top two bits of Move::data
+ */
+enum MoveFlag : std::uint16_t {
+    NORMAL_MOVE = 0,       ///< Quiet move or ordinary capture (including a double pawn push)
+    PROMOTION = 1 << 14,   ///< Pawn reaching the last row; see Move::promotionType()
+    EN_PASSANT = 2 << 14,  ///< Pawn capturing the pawn that just passed it
+    CASTLING = 3 << 14     ///< King moving two squares; the rook moves with it
+};
+
+/**
+ * @struct Move
+ * @brief A piece movement between two squares (row * 8 + col)
+ *
+ * Bits 0-5 hold the source square, bits 6-11 the target square, bits
+ * 12-13 the promotion piece (knight, bishop, rook, queen) and bits 14-15
+ * the MoveFlag.
+ */
+struct Move {
+    std::uint16_t data;  ///< Packed move
+
+    /**
+     * @brief Default constructor
+     * Leaves the move uninitialized so move lists can be declared for free
+     */
+    Move() = default;
+
+    /**
+     * @brief Parameterized constructor
+     * @param from Source square
+     * @param to Target square
+     * @param flag Kind of move
+     */
+    Move(int from, int to, MoveFlag flag = NORMAL_MOVE)
+        : data(static_cast<std::uint16_t>(from | (to << 6) | flag)) {}
+
+    /**
+     * @brief Creates a promotion
+     * @param from Source square
+     * @param to Target square on the last row
+     * @param piece QUEEN, ROOK, BISHOP or KNIGHT
+     * @return Packed promotion move
+     */
+    static Move promotion(int from, int to, PieceType piece) {
+        int index = piece == PieceType::QUEEN ? 3 : piece == PieceType::ROOK ? 2 : piece == PieceType::BISHOP ? 1 : 0;
+        Move move(from, to, PROMOTION);
+        move.data |= static_cast<std::uint16_t>(index << 12);
+        return move;
+    }
+
+    /**
+     * @brief Gets the source square
+     * @return int Square index (0-63)
+     */
+    int from() const { return data & 63; }
+
+    /**
+     * @brief Gets the target square
+     * @return int Square index (0-63)
+     */
+    int to() const { return (data >> 6) & 63; }
+
+    /**
+     * @brief Gets the kind of move
+     * @return MoveFlag Flag bits of the move
+     */
+    MoveFlag flag() const { return static_cast<MoveFlag>(data & (3 << 14)); }
+
+    /**
+     * @brief Checks if the move promotes a pawn
+     * @return bool True for a promotion
+     */
+    bool isPromotion() const { return flag() == PROMOTION; }
+
+    /**
+     * @brief Gets the piece a promotion creates
+     * @return PieceType Promotion piece, NONE if the move is not a promotion
+     */
+    PieceType promotionType() const {
+        static const PieceType pieces[4] = { PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN };
+        return isPromotion() ? pieces[(data >> 12) & 3] : PieceType::NONE;
+    }
+
+    /**
+     * @brief Returns the move from a8 to a8, used to mean "no move"
+     * @return Move that is never legal
+     */
+    static Move none() { return Move(0, 0); }
+
+    /**
+     * @brief Checks for the "no move" value
+     * @return bool True if this is Move::none()
+     */
+    bool isNone() const { return data == 0; }
+
+    bool operator==(const Move& other) const { return data == other.data; }
+    bool operator!=(const Move& other) const { return data != other.data; }
+};
+
+static_assert(sizeof(Move) == 2, "Move must stay packed into 16 bits");
+
+/**
+ * @class MoveList
+ * @brief Stack-allocated list of moves
+ *
+ * No chess position has more than 218 legal moves, so the capacity of 256
+ * is never exceeded and no bounds checks are made when adding.
+ */
+class MoveList {
+public:
+    static const int CAPACITY = 256;  ///< Maximum number of moves held
+
+private:
+    Move moves[CAPACITY];  ///< Storage for the moves
+    int count;             ///< Number of moves currently held
+
+public:
+    /**
+     * @brief Constructor
+     * Creates an empty list
+     */
+    MoveList() : count(0) {}
+
+    /**
+     * @brief Appends a move
+     * @param move Move to append
+     */
+    void add(const Move& move) { moves[count++] = move; }
+
+    /**
+     * @brief Appends a move
+     * @param from Source square
+     * @param to Target square
+     * @param flag Kind of move
+     */
+    void add(int from, int to, MoveFlag flag = NORMAL_MOVE) { moves[count++] = Move(from, to, flag); }
+
+    /**
+     * @brief Removes every move
+     */
+    void clear() { count = 0; }
+
+    /**
+     * @brief Shrinks the list, dropping the moves past the new size
+     * @param newSize Number of moves to keep
+     */
+    void resize(int newSize) { count = newSize; }
+
+    /**
+     * @brief Gets the number of moves
+     * @return int Number of moves in the list
+     */
+    int size() const { return count; }
+
+    /**
+     * @brief Checks if the list is empty
+     * @return bool True if the list holds no moves
+     */
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Checks if the list holds a move between two squares
+     * @param from Source square
+     * @param to Target square
+     * @return bool True if a move with these squares is in the list,
+     *         whatever its flag or promotion piece
+     */
+    bool contains(int from, int to) const {
+        for (int i = 0; i < count; i++) {
+            if (moves[i].from() == from && moves[i].to() == to) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks if the list holds a move
+     * @param move Move to look for, compared with its flag and promotion piece
+     * @return bool True if the move is in the list
+     */
+    bool contains(const Move& move) const {
+        for (int i = 0; i < count; i++) {
+            if (moves[i] == move) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Move& operator[](int index) { return moves[index]; }
+    const Move& operator[](int index) const { return moves[index]; }
+
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+};
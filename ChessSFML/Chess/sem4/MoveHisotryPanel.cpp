@@ -1,6 +1,28 @@
 #include "MoveHistoryPanel.h"
+#include "Bitboard.h"
 #include <algorithm>
 
+ChessMove ChessMove::fromMove(const Move& move, const std::string& note, bool white, bool check, bool mate,
+    PieceType capturedType, PieceColor capturedColor) {
+    ChessMove result(note, white, check, mate, capturedType, capturedColor, move.isPromotion());
+
+    int fromRow = rowOf(move.from());
+    int fromCol = colOf(move.from());
+    int toCol = colOf(move.to());
+    result.setSourceCoords(fromRow, fromCol);
+    result.setDestCoords(rowOf(move.to()), toCol);
+
+    if (move.flag() == EN_PASSANT) {
+        result.setEnPassantCapture(true, fromRow, toCol);
+    }
+    else if (move.flag() == CASTLING) {
+        bool isKingside = toCol > fromCol;
+        result.setCastling(isKingside, isKingside ? 7 : 0, isKingside ? 5 : 3);
+    }
+
+    return result;
+}
+
 MoveHistoryPanel::MoveHistoryPanel(sf::RenderWindow& win, const sf::Vector2f& pos, const sf::Vector2f& sz)
     : window(&win),
     position(pos),
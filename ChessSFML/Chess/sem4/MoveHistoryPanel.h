@@ -138,6 +138,25 @@ struct ChessMove {
     {
     }
 
+    /**
+     * @brief Builds the history entry of a move made on the board
+     *
+     * Coordinates and the en passant, castling and promotion details are
+     * read from the packed move, so the board's move type is only expanded
+     * into a ChessMove when the history panel needs one.
+     *
+     * @param move The move as made on the board
+     * @param note Algebraic notation of the move
+     * @param white Whether it's a white player's move
+     * @param check Whether the move puts the opponent in check
+     * @param mate Whether the move results in checkmate
+     * @param capturedType Type of the captured piece (if any)
+     * @param capturedColor Color of the captured piece (if any)
+     * @return History entry describing the move
+     */
+    static ChessMove fromMove(const Move& move, const std::string& note, bool white, bool check, bool mate,
+        PieceType capturedType, PieceColor capturedColor);
+
     /**
      * @brief Sets the source coordinates of the moved piece
      * @param row Source row
@@ -0,0 +1,221 @@
+#include "MovePicker.h"
+#include <cstdlib>
+
+namespace {
+    /// Victim and attacker rank for capture ordering, indexed by PieceType
+    const int captureRanks[7] = { 0, 4, 2, 3, 6, 5, 1 };
+
+    /// Largest history change one cutoff makes
+    const int MAX_HISTORY_BONUS = 1024;
+
+    /**
+     * @brief Moves a history score towards a bonus or a malus
+     *
+     * The closer the score already is to the limit, the less it moves, so
+     * scores stay within MAX_HISTORY and recent results weigh the most.
+     */
+    void updateHistory(int& entry, int bonus) {
+        entry += bonus - entry * std::abs(bonus) / HistoryTables::MAX_HISTORY;
+    }
+
+    /// Index of a side in the history table
+    int sideIndex(PieceColor side) { return side == PieceColor::WHITE ? 0 : 1; }
+}
+
+void HistoryTables::clear() {
+    for (auto& ply : killers) {
+        ply[0] = Move::none();
+        ply[1] = Move::none();
+    }
+    for (auto& from : counterMoves) {
+        for (Move& move : from) {
+            move = Move::none();
+        }
+    }
+    for (auto& side : history) {
+        for (auto& from : side) {
+            for (int& score : from) {
+                score = 0;
+            }
+        }
+    }
+}
+
+void HistoryTables::recordCutoff(PieceColor side, int ply, int depth, Move previous, Move move, const Move* failed, int failedCount) {
+    if (ply < MAX_PLY && killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+    if (!previous.isNone()) {
+        counterMoves[previous.from()][previous.to()] = move;
+    }
+
+    int bonus = depth * depth < MAX_HISTORY_BONUS ? depth * depth : MAX_HISTORY_BONUS;
+    auto& sideHistory = history[sideIndex(side)];
+    updateHistory(sideHistory[move.from()][move.to()], bonus);
+    for (int i = 0; i < failedCount; i++) {
+        updateHistory(sideHistory[failed[i].from()][failed[i].to()], -bonus);
+    }
+}
+
+MovePicker::MovePicker(const ChessBoard& position, Move tableMove, const HistoryTables& historyTables, int ply)
+    : board(position), tables(historyTables), stage(Stage::HASH_MOVE), capturesOnly(false), hashMove(Move::none()),
+    previous(position.getLastMove()), specialCount(0), specialIndex(0), current(0), badIndex(0) {
+    if (board.isLegalMove(tableMove)) {
+        hashMove = tableMove;
+    }
+
+    // Killers and the counter-move are remembered moves from other
+    // positions, so they go only if they are quiet and legal here
+    Move candidates[3] = {
+        ply < HistoryTables::MAX_PLY ? tables.killers[ply][0] : Move::none(),
+        ply < HistoryTables::MAX_PLY ? tables.killers[ply][1] : Move::none(),
+        previous.isNone() ? Move::none() : tables.counterMoves[previous.from()][previous.to()]
+    };
+    for (const Move& candidate : candidates) {
+        if (candidate.isNone() || candidate == hashMove || candidate.isPromotion() || board.isCapture(candidate)) {
+            continue;
+        }
+        bool duplicate = false;
+        for (int i = 0; i < specialCount; i++) {
+            duplicate = duplicate || specials[i] == candidate;
+        }
+        if (!duplicate) {
+            specials[specialCount++] = candidate;
+        }
+    }
+}
+
+MovePicker::MovePicker(const ChessBoard& position, const HistoryTables& historyTables)
+    : board(position), tables(historyTables), stage(Stage::GENERATE_CAPTURES), capturesOnly(true), hashMove(Move::none()),
+    previous(Move::none()), specialCount(0), specialIndex(0), current(0), badIndex(0) {
+}
+
+Move MovePicker::next() {
+    switch (stage) {
+    case Stage::HASH_MOVE:
+        stage = Stage::GENERATE_CAPTURES;
+        if (!hashMove.isNone()) {
+            return hashMove;
+        }
+        // fall through
+
+    case Stage::GENERATE_CAPTURES:
+        moves.clear();
+        board.generateLegalMoves(moves, MoveGenType::CAPTURES);
+        for (int i = 0; i < moves.size(); i++) {
+            const Move& move = moves[i];
+            int from = move.from();
+            int to = move.to();
+            PieceType victim = move.flag() == EN_PASSANT ? PieceType::PAWN : codeType(board.getPieceCode(rowOf(to), colOf(to)));
+            PieceType attacker = codeType(board.getPieceCode(rowOf(from), colOf(from)));
+            scores[i] = captureRanks[static_cast<int>(victim)] * 8 - captureRanks[static_cast<int>(attacker)] +
+                captureRanks[static_cast<int>(move.promotionType())] * 8;
+        }
+        current = 0;
+        stage = Stage::GOOD_CAPTURES;
+        // fall through
+
+    case Stage::GOOD_CAPTURES:
+        for (Move move = pickBest(); !move.isNone(); move = pickBest()) {
+            if (move == hashMove) {
+                continue;
+            }
+            if (isLosingCapture(move)) {
+                badCaptures.add(move);
+                continue;
+            }
+            return move;
+        }
+        if (capturesOnly) {
+            stage = Stage::DONE;
+            break;
+        }
+        stage = Stage::KILLERS;
+        // fall through
+
+    case Stage::KILLERS:
+        while (specialIndex < specialCount) {
+            Move move = specials[specialIndex++];
+            if (board.isLegalMove(move)) {
+                return move;
+            }
+        }
+        stage = Stage::GENERATE_QUIETS;
+        // fall through
+
+    case Stage::GENERATE_QUIETS: {
+        moves.clear();
+        board.generateLegalMoves(moves, MoveGenType::QUIETS);
+        const auto& sideHistory = tables.history[sideIndex(board.getSideToMove())];
+        for (int i = 0; i < moves.size(); i++) {
+            scores[i] = sideHistory[moves[i].from()][moves[i].to()];
+        }
+        current = 0;
+        stage = Stage::QUIETS;
+    }
+        // fall through
+
+    case Stage::QUIETS:
+        for (Move move = pickBest(); !move.isNone(); move = pickBest()) {
+            if (!alreadyTried(move)) {
+                return move;
+            }
+        }
+        stage = Stage::BAD_CAPTURES;
+        // fall through
+
+    case Stage::BAD_CAPTURES:
+        if (badIndex < badCaptures.size()) {
+            return badCaptures[badIndex++];
+        }
+        stage = Stage::DONE;
+        // fall through
+
+    case Stage::DONE:
+        break;
+    }
+    return Move::none();
+}
+
+Move MovePicker::pickBest() {
+    if (current >= moves.size()) {
+        return Move::none();
+    }
+
+    // Selection rather than a full sort: after a cutoff the rest of the
+    // list is never looked at
+    int best = current;
+    for (int i = current + 1; i < moves.size(); i++) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    Move move = moves[best];
+    int score = scores[best];
+    moves[best] = moves[current];
+    scores[best] = scores[current];
+    moves[current] = move;
+    scores[current] = score;
+    current++;
+    return move;
+}
+
+bool MovePicker::isLosingCapture(Move move) const {
+    if (move.isPromotion() && move.promotionType() != PieceType::QUEEN) {
+        return true;
+    }
+    return board.staticExchange(move) < 0;
+}
+
+bool MovePicker::alreadyTried(Move move) const {
+    if (move == hashMove) {
+        return true;
+    }
+    for (int i = 0; i < specialCount; i++) {
+        if (specials[i] == move) {
+            return true;
+        }
+    }
+    return false;
+}
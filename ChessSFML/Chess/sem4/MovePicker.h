@@ -0,0 +1,150 @@
+/**
+ * @file MovePicker.h
+ * @brief Staged move ordering for the engine search
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Alpha-beta search cuts off as soon as one move is good enough, so most
+ * nodes never look past their first few moves. The picker therefore hands
+ * out moves in stages, most promising first, and does the work of a stage
+ * only when the search asks for a move from it:
+ *
+ *  1. the transposition table move,
+ *  2. captures and promotions that do not lose material by static exchange
+ *     evaluation, by most valuable victim and least valuable attacker
+ *     (MVV-LVA),
+ *  3. the killer moves of the ply and the counter-move to the previous move,
+ *  4. the remaining quiet moves, by history score,
+ *  5. the captures put aside in stage 2 as losing.
+ *
+ * Quiet moves are not even generated while a capture or killer is still
+ * on offer. For the quiescence search the picker stops after stage 2.
+ */
+
+#pragma once
+#include "ChessBoard.h"
+
+/**
+ * @struct HistoryTables
+ * @brief Quiet-move statistics of one search thread
+ *
+ * Quiet moves that caused a beta cutoff are likely to do so again in
+ * similar positions; these tables remember them for the move picker.
+ */
+struct HistoryTables {
+    static const int MAX_PLY = 64;             ///< Plies with killer slots
+    static const int MAX_HISTORY = 1 << 14;    ///< History scores stay below this in magnitude
+
+    Move killers[MAX_PLY][2];   ///< Last two quiet cutoff moves per ply, newest first
+    Move counterMoves[64][64];  ///< Quiet cutoff reply, indexed by from and to square of the move answered
+    int history[2][64][64];     ///< Quiet move score, indexed by side, from and to square
+
+    /**
+     * @brief Forgets every statistic
+     */
+    void clear();
+
+    /**
+     * @brief Records a quiet move that caused a beta cutoff
+     *
+     * The move becomes the first killer of the ply and the counter-move
+     * to the previous move, and gains history; the quiet moves searched
+     * before it without a cutoff lose history.
+     *
+     * @param side Side that made the move
+     * @param ply Distance of the node from the root
+     * @param depth Remaining depth of the node
+     * @param previous Move that led to the node, Move::none() at the root
+     * @param move The cutoff move
+     * @param failed Quiet moves searched before it
+     * @param failedCount Number of moves in failed
+     */
+    void recordCutoff(PieceColor side, int ply, int depth, Move previous, Move move, const Move* failed, int failedCount);
+};
+
+/**
+ * @class MovePicker
+ * @brief Hands out the legal moves of a position one at a time, best first
+ */
+class MovePicker {
+private:
+    /**
+     * @enum Stage
+     * @brief What the picker hands out next
+     */
+    enum class Stage {
+        HASH_MOVE,
+        GENERATE_CAPTURES,
+        GOOD_CAPTURES,
+        KILLERS,
+        GENERATE_QUIETS,
+        QUIETS,
+        BAD_CAPTURES,
+        DONE
+    };
+
+    const ChessBoard& board;       ///< Position the moves are for
+    const HistoryTables& tables;   ///< Statistics the quiet moves are ordered by
+    Stage stage;                   ///< Current stage
+    bool capturesOnly;             ///< Stop after the good captures (quiescence search)
+    Move hashMove;                 ///< Table move, Move::none() if none or illegal
+    Move previous;                 ///< Move that led to the position
+
+    Move specials[3];              ///< Killers and counter-move of the KILLERS stage
+    int specialCount;              ///< Moves in specials
+    int specialIndex;              ///< Next move of specials to try
+
+    MoveList moves;                ///< Moves of the current generating stage
+    int scores[MoveList::CAPACITY];  ///< Ordering score of each move in moves
+    int current;                   ///< Next move of moves to hand out
+
+    MoveList badCaptures;          ///< Losing captures, in MVV-LVA order
+    int badIndex;                  ///< Next move of badCaptures to hand out
+
+    /**
+     * @brief Moves the best-scored remaining move to position current and returns it
+     * @return The move, Move::none() if moves is exhausted
+     */
+    Move pickBest();
+
+    /**
+     * @brief Tells whether a capture or promotion loses material
+     *
+     * A capture loses when its static exchange evaluation is negative; an
+     * underpromotion always counts as losing.
+     *
+     * @param move Capture or promotion of the side to move
+     * @return true if the move belongs to the last stage
+     */
+    bool isLosingCapture(Move move) const;
+
+    /**
+     * @brief Tells whether a move was already handed out by an earlier stage
+     * @param move Move from a generating stage
+     * @return true if it is the hash move or one of the specials
+     */
+    bool alreadyTried(Move move) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param position Position to pick moves for; must not change while the picker is used
+     * @param tableMove Move from the transposition table, Move::none() for none
+     * @param historyTables Killers, counter-moves and history of the searching thread
+     * @param ply Distance of the position from the root
+     */
+    MovePicker(const ChessBoard& position, Move tableMove, const HistoryTables& historyTables, int ply);
+
+    /**
+     * @brief Constructor for the quiescence search: captures and queen promotions that do not lose material
+     * @param position Position to pick moves for; must not change while the picker is used
+     * @param historyTables Statistics of the searching thread
+     */
+    MovePicker(const ChessBoard& position, const HistoryTables& historyTables);
+
+    /**
+     * @brief Returns the next move
+     * @return Next legal move, Move::none() once every move was handed out
+     */
+    Move next();
+};
@@ -8,8 +8,10 @@ OptionsScreen::OptionsScreen(sf::RenderWindow& win, ApplicationManager* manager)
     volumeSlider(175, 150, 250, 20, 0, 100),
     whiteTimeInput(sf::Vector2f(200, 310), sf::Vector2f(200, 40), "White Player Time"),
     blackTimeInput(sf::Vector2f(200, 380), sf::Vector2f(200, 40), "Black Player Time"),
+    computerTimeSlider(175, 465, 250, 20, 1, 10),
     isMusicEnabled(false),
     volumeLevel(100),
+    computerMoveSeconds(manager ? manager->getComputerMoveTime() : 3),
     appManager(manager)
 {
     if (!titleFont.loadFromFile("resources/fonts/arial.ttf")) {
@@ -40,6 +42,13 @@ OptionsScreen::OptionsScreen(sf::RenderWindow& win, ApplicationManager* manager)
     timerSettingsTitle.setOrigin(timerTitleRect.width / 2, 0);
     timerSettingsTitle.setPosition(300, 230);
 
+    computerTimeText.setFont(titleFont);
+    computerTimeText.setCharacterSize(20);
+    computerTimeText.setFillColor(sf::Color::White);
+    computerTimeText.setPosition(175, 430);
+    computerTimeSlider.setValue(computerMoveSeconds);
+    updateComputerTimeText();
+
     whiteTimeInput.setTime(10, 0);
     blackTimeInput.setTime(10, 0);
 
@@ -61,6 +70,10 @@ void OptionsScreen::updateVolumeText() {
     volumeText.setString("Volume: " + std::to_string(volumeLevel) + "%");
 }
 
+void OptionsScreen::updateComputerTimeText() {
+    computerTimeText.setString("Computer time per move: " + std::to_string(computerMoveSeconds) + " s");
+}
+
 std::string OptionsScreen::handleEvent(const sf::Event& event) {
     sf::Vector2i mousePos = sf::Mouse::getPosition(window);
 
@@ -80,6 +93,12 @@ std::string OptionsScreen::handleEvent(const sf::Event& event) {
             updateVolumeText();
             updateVolume();
         }
+        else if (computerTimeSlider.isClicked(mousePos)) {
+            computerTimeSlider.startDragging();
+            computerMoveSeconds = computerTimeSlider.updateValue(mousePos);
+            updateComputerTimeText();
+            updateComputerTime();
+        }
     }
     else if (event.type == sf::Event::MouseMoved) {
         if (volumeSlider.isDragging()) {
@@ -87,9 +106,15 @@ std::string OptionsScreen::handleEvent(const sf::Event& event) {
             updateVolumeText();
             updateVolume();
         }
+        if (computerTimeSlider.isDragging()) {
+            computerMoveSeconds = computerTimeSlider.updateValue(mousePos);
+            updateComputerTimeText();
+            updateComputerTime();
+        }
     }
     else if (event.type == sf::Event::MouseButtonReleased) {
         volumeSlider.stopDragging();
+        computerTimeSlider.stopDragging();
     }
 
     return "current";
@@ -101,6 +126,7 @@ void OptionsScreen::update() {
     backButton.update(mousePos);
     musicToggleButton.update(mousePos);
     volumeSlider.update(mousePos);
+    computerTimeSlider.update(mousePos);
 
     whiteTimeInput.update(mousePos);
     blackTimeInput.update(mousePos);
@@ -122,10 +148,12 @@ void OptionsScreen::render() {
     window.draw(titleText);
     window.draw(volumeText);
     window.draw(timerSettingsTitle);
+    window.draw(computerTimeText);
 
     backButton.render(window);
     musicToggleButton.render(window);
     volumeSlider.render(window);
+    computerTimeSlider.render(window);
     whiteTimeInput.render(window);
     blackTimeInput.render(window);
 }
@@ -134,6 +162,7 @@ void OptionsScreen::onEnter() {}
 
 void OptionsScreen::onExit() {
     updateTimers();
+    updateComputerTime();
 }
 
 void OptionsScreen::toggleMusic() {
@@ -160,4 +189,10 @@ void OptionsScreen::updateTimers() {
         appManager->setWhitePlayerTime(whiteTimeInput.getTotalSeconds());
         appManager->setBlackPlayerTime(blackTimeInput.getTotalSeconds());
     }
+}
+
+void OptionsScreen::updateComputerTime() {
+    if (appManager) {
+        appManager->setComputerMoveTime(computerMoveSeconds);
+    }
 }
\ No newline at end of file
@@ -18,7 +18,8 @@ class ApplicationManager;
  * @brief Manages the options/settings screen of the chess application
  *
  * This class provides a user interface for adjusting game settings such as
- * music, volume and chess timer settings for both players.
+ * music, volume, chess timer settings for both players and the thinking
+ * time of the computer opponent.
  * It inherits from the Screen base class.
  */
 class OptionsScreen : public Screen {
@@ -38,6 +39,9 @@ private:
     /** @brief Time input field for the black player */
     TimeInputField blackTimeInput;
 
+    /** @brief Slider to adjust the computer's thinking time per move */
+    Slider computerTimeSlider;
+
     /** @brief Background texture for the options screen */
     sf::Texture backgroundTexture;
 
@@ -56,12 +60,18 @@ private:
     /** @brief Text element for the timer settings section title */
     sf::Text timerSettingsTitle;
 
+    /** @brief Text element for displaying the computer's thinking time */
+    sf::Text computerTimeText;
+
     /** @brief Flag indicating whether music is enabled */
     bool isMusicEnabled;
 
     /** @brief Integer representing volume level (0-100) */
     int volumeLevel;
 
+    /** @brief Computer's thinking time per move in seconds (1-10) */
+    int computerMoveSeconds;
+
     /** @brief Pointer to the ApplicationManager for updating global settings */
     ApplicationManager* appManager;
 
@@ -79,6 +89,11 @@ public:
      */
     void updateVolumeText();
 
+    /**
+     * @brief Updates the computer time text based on the current setting
+     */
+    void updateComputerTimeText();
+
     /**
      * @brief Handles user input events
      *
@@ -136,4 +151,9 @@ private:
      * Transfers the time values from input fields to the application
      */
     void updateTimers();
+
+    /**
+     * @brief Updates the computer's thinking time in the ApplicationManager
+     */
+    void updateComputerTime();
 };
\ No newline at end of file
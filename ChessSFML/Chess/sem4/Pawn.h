@@ -6,8 +6,6 @@
  */
 
 #pragma once
-#include <vector>
-#include <SFML/System/Vector2.hpp>
 #include "Piece.h"
 
 class ChessBoard;
@@ -28,23 +26,4 @@ public:
      * @param color The color of the pawn (WHITE or BLACK)
      */
     Pawn(PieceColor color);
-
-    /**
-     * @brief Gets all possible moves for this pawn
-     * @param row Current row position of the pawn
-     * @param col Current column position of the pawn
-     * @param board Reference to the chess board
-     * @return Vector of possible destination coordinates
-     *
-     * Calculates all valid moves for the pawn from the current position,
-     * including:
-     * - Moving one square forward (if unblocked)
-     * - Moving two squares forward from starting position (if unblocked)
-     * - Capturing diagonally (if opponent piece is present)
-     * - En passant captures (if available)
-     *
-     * Note: The promotion of a pawn is handled separately in the game logic
-     * when a pawn reaches the opposite end of the board.
-     */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const override;
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "Perft.h"
+#include <atomic>
+#include <thread>
+
+std::uint64_t Perft::count(ChessBoard& board, int depth) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    // Last ply: count the moves instead of playing them
+    if (depth == 1) {
+        return static_cast<std::uint64_t>(moves.size());
+    }
+
+    std::uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        board.makeLegalMove(move);
+        nodes += count(board, depth - 1);
+        board.unmakeMove();
+    }
+    return nodes;
+}
+
+std::vector<PerftDivideEntry> Perft::divide(const std::string& fen, int depth, int threads) {
+    std::vector<PerftDivideEntry> entries;
+
+    ChessBoard root;
+    if (!root.loadFen(fen)) {
+        return entries;
+    }
+
+    MoveList moves;
+    root.generateLegalMoves(moves);
+    for (const Move& move : moves) {
+        entries.push_back({ move, 0 });
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&] {
+        ChessBoard board;
+        board.loadFen(fen);
+        for (std::size_t i = next++; i < entries.size(); i = next++) {
+            PerftDivideEntry& entry = entries[i];
+            board.makeLegalMove(entry.move);
+            entry.nodes = count(board, depth - 1);
+            board.unmakeMove();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    return entries;
+}
+
+std::string Perft::moveToString(const Move& move) {
+    std::string text;
+    text += static_cast<char>('a' + colOf(move.from()));
+    text += static_cast<char>('8' - rowOf(move.from()));
+    text += static_cast<char>('a' + colOf(move.to()));
+    text += static_cast<char>('8' - rowOf(move.to()));
+
+    switch (move.promotionType()) {
+    case PieceType::QUEEN:  text += 'q'; break;
+    case PieceType::ROOK:   text += 'r'; break;
+    case PieceType::BISHOP: text += 'b'; break;
+    case PieceType::KNIGHT: text += 'n'; break;
+    default: break;
+    }
+    return text;
+}
+
+const std::vector<PerftCase>& Perft::referenceSuite() {
+    static const std::vector<PerftCase> suite = {
+        { "start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609 },
+        { "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603 },
+        { "position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083 },
+        { "position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292 },
+        { "position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487 },
+        { "position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594 },
+        { "en passant exposes own king", "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, 1134888 },
+        { "en passant capture gives check", "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, 1440467 },
+        { "en passant after double push", "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", 6, 1015133 },
+        { "short castling gives check", "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072 },
+        { "long castling gives check", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711 },
+        { "castling rights lost", "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, 1274206 },
+        { "castling prevented", "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, 1720476 },
+        { "promotion out of check", "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 6, 3821001 },
+        { "discovered check", "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, 1004658 },
+        { "promotion gives check", "4k3/1P6/8/8/8/8/K7/8 w - - 0 1", 6, 217342 },
+        { "underpromotion gives check", "8/P1k5/K7/8/8/8/8/8 w - - 0 1", 6, 92683 },
+        { "self stalemate", "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 2217 },
+        { "stalemate and checkmate", "8/k1P5/8/1K6/8/8/8/8 w - - 0 1", 7, 567584 },
+        { "double check", "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527 },
+    };
+    return suite;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file Perft.h
+ * @brief Move-path enumeration used to validate move generation
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Perft counts the leaf nodes of the legal move tree to a fixed depth.
+ * Comparing the counts with published values exercises every move rule
+ * (castling, en passant, promotion, pins, checks) and gives a repeatable
+ * workload for measuring move generation speed.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ChessBoard.h"
+
+/**
+ * @struct PerftDivideEntry
+ * @brief Node count below one root move
+ */
+struct PerftDivideEntry {
+    Move move;            ///< Root move
+    std::uint64_t nodes;  ///< Leaf nodes below the move
+};
+
+/**
+ * @struct PerftCase
+ * @brief Reference position with its published node count
+ */
+struct PerftCase {
+    const char* name;     ///< Short description of what the position tests
+    const char* fen;      ///< Position in Forsyth-Edwards Notation
+    int depth;            ///< Depth the count refers to
+    std::uint64_t nodes;  ///< Expected leaf node count
+};
+
+/**
+ * @class Perft
+ * @brief Leaf node counting over ChessBoard's legal moves
+ */
+class Perft {
+public:
+    /**
+     * @brief Counts the leaf nodes below a position
+     *
+     * The board is returned in its original state.
+     *
+     * @param board Position to search from
+     * @param depth Number of plies (0 counts the position itself)
+     * @return Number of leaf nodes
+     */
+    static std::uint64_t count(ChessBoard& board, int depth);
+
+    /**
+     * @brief Counts the leaf nodes below each root move
+     *
+     * Root moves are shared out between threads; every thread sets the
+     * position up on its own board, so no board is touched by two threads.
+     *
+     * @param fen Root position in Forsyth-Edwards Notation
+     * @param depth Number of plies, at least 1
+     * @param threads Number of worker threads (values below 1 mean 1)
+     * @return One entry per root move in generation order, empty if the
+     *         FEN could not be loaded
+     */
+    static std::vector<PerftDivideEntry> divide(const std::string& fen, int depth, int threads);
+
+    /**
+     * @brief Formats a move in coordinate notation, e.g. "e2e4" or "e7e8q"
+     * @param move Move to format
+     * @return Move text
+     */
+    static std::string moveToString(const Move& move);
+
+    /**
+     * @brief Returns the built-in reference positions
+     *
+     * The standard start position, "Kiwipete" and the other widely used
+     * test positions, plus small positions aimed at en passant, castling
+     * and promotion corner cases.
+     *
+     * @return Reference positions with expected counts
+     */
+    static const std::vector<PerftCase>& referenceSuite();
+};
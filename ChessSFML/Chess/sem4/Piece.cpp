@@ -0,0 +1,6 @@
+#include "Piece.h"
+#include "ChessBoard.h"
+
+void Piece::getPossibleMoves(int row, int col, const ChessBoard& board, MoveList& moves) const {
+    board.generatePieceMoves(makeSquare(row, col), type, color, moves);
+}
\ No newline at end of file
@@ -8,41 +8,19 @@
  */
 #pragma once
 
-#include <vector>
-#include <SFML/System/Vector2.hpp>
+#include "Move.h"
+#include "PieceCode.h"
 
  // Forward declarations
 class ChessBoard;
 
-/**
- * @enum PieceType
- * @brief Enumeration of possible chess piece types
- */
-enum class PieceType {
-    NONE,   ///< Represents an empty or unspecified piece
-    ROOK,   ///< Rook piece
-    KNIGHT, ///< Knight piece
-    BISHOP, ///< Bishop piece
-    KING,   ///< King piece
-    QUEEN,  ///< Queen piece
-    PAWN    ///< Pawn piece
-};
-
-/**
- * @enum PieceColor
- * @brief Enumeration of possible piece colors
- */
-enum class PieceColor {
-    NONE,   ///< Represents an unspecified color
-    WHITE,  ///< White pieces
-    BLACK   ///< Black pieces
-};
-
 /**
  * @class Piece
- * @brief Abstract base class for chess pieces
+ * @brief Base class for chess pieces
  *
- * Provides common functionality and interface for all chess pieces
+ * ChessBoard stores one PieceCode per square; piece objects are a facade
+ * over it for code that prefers an object per piece. Movement rules live
+ * in the board, so the piece classes only carry type, color and moved state.
  */
 class Piece {
 protected:
@@ -137,14 +115,16 @@ public:
     /**
      * @brief Get all possible moves for this piece
      *
-     * Pure virtual method to be implemented by derived classes
+     * Forwards to ChessBoard::generatePieceMoves() with this piece's type
+     * and color. Moves are appended, so one list can collect the moves of
+     * several pieces.
      *
      * @param row Current row of the piece
      * @param col Current column of the piece
      * @param board Reference to the chess board
-     * @return std::vector<sf::Vector2i> List of possible move coordinates
+     * @param moves List the possible moves are appended to
      */
-    virtual std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const = 0;
+    void getPossibleMoves(int row, int col, const ChessBoard& board, MoveList& moves) const;
 };
 
 /**
@@ -160,20 +140,6 @@ public:
      * Creates an empty piece with no type or color
      */
     EmptyPiece() : Piece(PieceType::NONE, PieceColor::NONE) {}
-
-    /**
-     * @brief Get possible moves
-     *
-     * Always returns an empty vector as an empty piece cannot move
-     *
-     * @param row Current row (unused)
-     * @param col Current column (unused)
-     * @param board Chess board reference (unused)
-     * @return std::vector<sf::Vector2i> Empty vector
-     */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const override {
-        return {}; // Empty square has no moves
-    }
 };
 
 // Forward declarations for specific piece classes
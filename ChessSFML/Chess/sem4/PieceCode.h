@@ -0,0 +1,78 @@
+/**
+ * @file PieceCode.h
+ * @brief Piece enumerations and the one-byte piece encoding used by the board
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @enum PieceType
+ * @brief Enumeration of possible chess piece types
+ */
+enum class PieceType : std::uint8_t {
+    NONE,   ///< Represents an empty or unspecified piece
+    ROOK,   ///< Rook piece
+    KNIGHT, ///< Knight piece
+    BISHOP, ///< Bishop piece
+    KING,   ///< King piece
+    QUEEN,  ///< Queen piece
+    PAWN    ///< Pawn piece
+};
+
+/**
+ * @enum PieceColor
+ * @brief Enumeration of possible piece colors
+ */
+enum class PieceColor : std::uint8_t {
+    NONE,   ///< Represents an unspecified color
+    WHITE,  ///< White pieces
+    BLACK   ///< Black pieces
+};
+
+/**
+ * @brief One-byte piece value stored per square by ChessBoard
+ *
+ * Bits 0-2 hold the PieceType and bit 3 is set for black pieces, so white
+ * pieces are 1-6, black pieces 9-14 and 0 is an empty square.
+ */
+using PieceCode = std::uint8_t;
+
+/**
+ * @brief Code of an empty square
+ */
+const PieceCode NO_PIECE = 0;
+
+/**
+ * @brief Builds the code of a piece
+ * @param type Piece type (NONE gives NO_PIECE)
+ * @param color Piece color
+ * @return Piece code
+ */
+inline PieceCode makePieceCode(PieceType type, PieceColor color) {
+    if (type == PieceType::NONE) {
+        return NO_PIECE;
+    }
+    return static_cast<PieceCode>(static_cast<int>(type) | (color == PieceColor::BLACK ? 8 : 0));
+}
+
+/**
+ * @brief Extracts the piece type from a code
+ * @param code Piece code
+ * @return Piece type, NONE for an empty square
+ */
+inline PieceType codeType(PieceCode code) { return static_cast<PieceType>(code & 7); }
+
+/**
+ * @brief Extracts the piece color from a code
+ * @param code Piece code
+ * @return Piece color, NONE for an empty square
+ */
+inline PieceColor codeColor(PieceCode code) {
+    if (code == NO_PIECE) {
+        return PieceColor::NONE;
+    }
+    return (code & 8) ? PieceColor::BLACK : PieceColor::WHITE;
+}
@@ -0,0 +1,136 @@
+#include "PieceSquare.h"
+#include <mutex>
+
+std::int16_t PieceSquare::middlegameValues[16][64];
+std::int16_t PieceSquare::endgameValues[16][64];
+std::uint8_t PieceSquare::phaseWeights[16];
+
+namespace {
+    /// Material value in centipawns, indexed by PieceType
+    const int pieceValues[7] = { 0, 500, 320, 330, 0, 900, 100 };
+
+    /// Phase contribution, indexed by PieceType
+    const int phaseValues[7] = { 0, 2, 1, 1, 0, 4, 0 };
+
+    /**
+     * @brief Middlegame piece-square bonuses for white, indexed by PieceType and square
+     *
+     * Row 0 is the eighth rank, as on the board; black pieces read the
+     * table with the rows mirrored.
+     */
+    const int middlegameSquare[7][64] = {
+        {},
+        { // Rook
+              0,   0,   0,   0,   0,   0,   0,   0,
+              5,  10,  10,  10,  10,  10,  10,   5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+             -5,   0,   0,   0,   0,   0,   0,  -5,
+              0,   0,   0,   5,   5,   0,   0,   0 },
+        { // Knight
+            -50, -40, -30, -30, -30, -30, -40, -50,
+            -40, -20,   0,   0,   0,   0, -20, -40,
+            -30,   0,  10,  15,  15,  10,   0, -30,
+            -30,   5,  15,  20,  20,  15,   5, -30,
+            -30,   0,  15,  20,  20,  15,   0, -30,
+            -30,   5,  10,  15,  15,  10,   5, -30,
+            -40, -20,   0,   5,   5,   0, -20, -40,
+            -50, -40, -30, -30, -30, -30, -40, -50 },
+        { // Bishop
+            -20, -10, -10, -10, -10, -10, -10, -20,
+            -10,   0,   0,   0,   0,   0,   0, -10,
+            -10,   0,   5,  10,  10,   5,   0, -10,
+            -10,   5,   5,  10,  10,   5,   5, -10,
+            -10,   0,  10,  10,  10,  10,   0, -10,
+            -10,  10,  10,  10,  10,  10,  10, -10,
+            -10,   5,   0,   0,   0,   0,   5, -10,
+            -20, -10, -10, -10, -10, -10, -10, -20 },
+        { // King
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -30, -40, -40, -50, -50, -40, -40, -30,
+            -20, -30, -30, -40, -40, -30, -30, -20,
+            -10, -20, -20, -20, -20, -20, -20, -10,
+             20,  20,   0,   0,   0,   0,  20,  20,
+             20,  30,  10,   0,   0,  10,  30,  20 },
+        { // Queen
+            -20, -10, -10,  -5,  -5, -10, -10, -20,
+            -10,   0,   0,   0,   0,   0,   0, -10,
+            -10,   0,   5,   5,   5,   5,   0, -10,
+             -5,   0,   5,   5,   5,   5,   0,  -5,
+              0,   0,   5,   5,   5,   5,   0,  -5,
+            -10,   5,   5,   5,   5,   5,   0, -10,
+            -10,   0,   5,   0,   0,   0,   0, -10,
+            -20, -10, -10,  -5,  -5, -10, -10, -20 },
+        { // Pawn
+              0,   0,   0,   0,   0,   0,   0,   0,
+             50,  50,  50,  50,  50,  50,  50,  50,
+             10,  10,  20,  30,  30,  20,  10,  10,
+              5,   5,  10,  25,  25,  10,   5,   5,
+              0,   0,   0,  20,  20,   0,   0,   0,
+              5,  -5, -10,   0,   0, -10,  -5,   5,
+              5,  10,  10, -20, -20,  10,  10,   5,
+              0,   0,   0,   0,   0,   0,   0,   0 }
+    };
+
+    /**
+     * @brief Endgame bonuses for the pieces whose role changes, indexed by square
+     *
+     * With the queens gone the king has to walk to the centre, and a pawn
+     * is worth more the closer it is to promotion. The other pieces keep
+     * their middlegame bonuses.
+     */
+    const int endgameKing[64] = {
+        -50, -40, -30, -20, -20, -30, -40, -50,
+        -30, -20, -10,   0,   0, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -30,   0,   0,   0,   0, -30, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50 };
+
+    const int endgamePawn[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         80,  80,  80,  80,  80,  80,  80,  80,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         30,  30,  30,  30,  30,  30,  30,  30,
+         15,  15,  15,  15,  15,  15,  15,  15,
+          5,   5,   5,   5,   5,   5,   5,   5,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0 };
+}
+
+void PieceSquare::init() {
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        for (int code = 0; code < 16; code++) {
+            PieceType type = codeType(static_cast<PieceCode>(code));
+            PieceColor color = codeColor(static_cast<PieceCode>(code));
+            int index = static_cast<int>(type);
+            bool isPiece = index >= static_cast<int>(PieceType::ROOK) && index <= static_cast<int>(PieceType::PAWN) &&
+                color != PieceColor::NONE;
+            int sign = color == PieceColor::BLACK ? -1 : 1;
+
+            phaseWeights[code] = static_cast<std::uint8_t>(isPiece ? phaseValues[index] : 0);
+            for (int square = 0; square < 64; square++) {
+                if (!isPiece) {
+                    middlegameValues[code][square] = 0;
+                    endgameValues[code][square] = 0;
+                    continue;
+                }
+
+                // Black reads the white tables with the rows mirrored
+                int whiteSquare = color == PieceColor::BLACK ? square ^ 56 : square;
+                int endgameBonus = type == PieceType::KING ? endgameKing[whiteSquare]
+                    : type == PieceType::PAWN ? endgamePawn[whiteSquare]
+                    : middlegameSquare[index][whiteSquare];
+                middlegameValues[code][square] = static_cast<std::int16_t>(sign * (pieceValues[index] + middlegameSquare[index][whiteSquare]));
+                endgameValues[code][square] = static_cast<std::int16_t>(sign * (pieceValues[index] + endgameBonus));
+            }
+        }
+    });
+}
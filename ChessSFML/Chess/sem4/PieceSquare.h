@@ -0,0 +1,66 @@
+/**
+ * @file PieceSquare.h
+ * @brief Material and piece-square values for the incremental evaluation
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Every piece on a square is worth a fixed number of centipawns in the
+ * middlegame and another in the endgame: its material value plus a bonus
+ * for where it stands. The sums over all pieces therefore change by two
+ * table lookups whenever a piece is put on or taken off a square, and
+ * ChessBoard keeps them up to date the same way it keeps its Zobrist key.
+ *
+ * The game phase is counted the same way, from the minor and major pieces
+ * left on the board, and blends the two sums: a full set of pieces gives
+ * the middlegame score, bare kings and pawns the endgame score.
+ */
+
+#pragma once
+#include <cstdint>
+#include "PieceCode.h"
+
+/**
+ * @class PieceSquare
+ * @brief Value tables used by ChessBoard to maintain its evaluation sums
+ */
+class PieceSquare {
+public:
+    static const int MAX_PHASE = 24;  ///< Phase of the starting position; later phases are capped here
+
+private:
+    static std::int16_t middlegameValues[16][64];  ///< Middlegame value per piece code and square, negative for black
+    static std::int16_t endgameValues[16][64];     ///< Endgame value per piece code and square, negative for black
+    static std::uint8_t phaseWeights[16];          ///< Phase contribution per piece code
+
+public:
+    /**
+     * @brief Fills the value tables
+     *
+     * Safe to call any number of times from any thread; only the first
+     * call does work.
+     */
+    static void init();
+
+    /**
+     * @brief Returns the middlegame value of a piece on a square
+     * @param code Piece code (NO_PIECE gives 0)
+     * @param square Square index (0-63)
+     * @return Centipawns from white's point of view
+     */
+    static int middlegame(PieceCode code, int square) { return middlegameValues[code][square]; }
+
+    /**
+     * @brief Returns the endgame value of a piece on a square
+     * @param code Piece code (NO_PIECE gives 0)
+     * @param square Square index (0-63)
+     * @return Centipawns from white's point of view
+     */
+    static int endgame(PieceCode code, int square) { return endgameValues[code][square]; }
+
+    /**
+     * @brief Returns how much a piece counts towards the game phase
+     * @param code Piece code
+     * @return 1 per minor piece, 2 per rook, 4 per queen, 0 otherwise
+     */
+    static int phase(PieceCode code) { return phaseWeights[code]; }
+};
@@ -0,0 +1,75 @@
+/**
+ * @file Position.h
+ * @brief Plain value type holding the complete state of a chess position
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * Position carries everything needed to continue a game from a position:
+ * piece placement, side to move, castling rights, en passant state, the
+ * halfmove clock, the position key and the running evaluation sums. It
+ * has no pointers or owned resources, so a copy is a plain memcpy of
+ * under 100 bytes; ChessBoard keeps its state in one and hands out
+ * snapshots of it.
+ */
+
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "Bitboard.h"
+#include "PieceCode.h"
+
+/**
+ * @struct Position
+ * @brief Piece placement and game state of one chess position
+ */
+struct Position {
+    Bitboard typeBB[7];           ///< Squares per PieceType of either color; index 0 holds every occupied square
+    Bitboard colorBB[2];          ///< Squares per color (0 = white, 1 = black)
+    std::uint64_t key;            ///< Zobrist key, updated incrementally by ChessBoard
+    signed char kingSquares[2];   ///< Square of each side's king (0 = white, 1 = black), -1 if absent
+    signed char enPassantCol;     ///< Column for en passant capture (-1 if unavailable)
+    signed char enPassantRow;     ///< Row for en passant capture
+    std::uint8_t castlingRights;  ///< Castling rights still held (CastlingRight bits)
+    PieceColor sideToMove;        ///< Side whose turn it is
+    std::uint16_t halfmoveClock;  ///< Plies since the last capture or pawn move
+    std::int16_t middlegameScore; ///< Middlegame material and piece-square sum, white minus black
+    std::int16_t endgameScore;    ///< Endgame material and piece-square sum, white minus black
+    std::uint8_t phase;           ///< Game phase counted from the pieces on the board (see PieceSquare)
+
+    /**
+     * @brief Returns the type of the piece standing on a square
+     * @param square Square index (0-63)
+     * @return Piece type or PieceType::NONE if the square is empty
+     */
+    PieceType typeOn(int square) const {
+        Bitboard bb = squareBB(square);
+        if (!(typeBB[0] & bb)) {
+            return PieceType::NONE;
+        }
+        int type = static_cast<int>(PieceType::ROOK);
+        while (!(typeBB[type] & bb)) {
+            type++;
+        }
+        return static_cast<PieceType>(type);
+    }
+
+    /**
+     * @brief Returns the color of the piece standing on a square
+     * @param square Square index (0-63)
+     * @return Piece color or PieceColor::NONE if the square is empty
+     */
+    PieceColor colorOn(int square) const {
+        Bitboard bb = squareBB(square);
+        return (colorBB[0] & bb) ? PieceColor::WHITE : (colorBB[1] & bb) ? PieceColor::BLACK : PieceColor::NONE;
+    }
+
+    /**
+     * @brief Returns the code of the piece standing on a square
+     * @param square Square index (0-63)
+     * @return Piece code, NO_PIECE for an empty square
+     */
+    PieceCode pieceOn(int square) const { return makePieceCode(typeOn(square), colorOn(square)); }
+};
+
+static_assert(std::is_trivially_copyable<Position>::value, "Position must be copyable with memcpy");
+static_assert(sizeof(Position) <= 100, "Position must stay within 100 bytes");
@@ -0,0 +1,182 @@
+#include "PositionBatch.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include "Attacks.h"
+#include "ChessBoard.h"
+
+namespace {
+    /// Rows 0 and 7, where no pawn can stand
+    const Bitboard backRanks = 0xFF000000000000FFULL;
+
+    /**
+     * @brief Checks that a bitboard holds exactly one square
+     * @param b Bitboard to test
+     * @return true for a single set bit
+     */
+    inline bool singleSquare(Bitboard b) { return (b != 0) & ((b & (b - 1)) == 0); }
+}
+
+void PositionBatch::reserve(std::size_t count) {
+    for (std::vector<Bitboard>& column : typeBB) {
+        column.reserve(count);
+    }
+    colorBB[0].reserve(count);
+    colorBB[1].reserve(count);
+    keys.reserve(count);
+    enPassantCols.reserve(count);
+    enPassantRows.reserve(count);
+    castlingRights.reserve(count);
+    sidesToMove.reserve(count);
+    halfmoveClocks.reserve(count);
+    middlegameScores.reserve(count);
+    endgameScores.reserve(count);
+    phases.reserve(count);
+}
+
+void PositionBatch::add(const Position& position) {
+    for (int type = 0; type < 7; type++) {
+        typeBB[type].push_back(position.typeBB[type]);
+    }
+    colorBB[0].push_back(position.colorBB[0]);
+    colorBB[1].push_back(position.colorBB[1]);
+    keys.push_back(position.key);
+    enPassantCols.push_back(position.enPassantCol);
+    enPassantRows.push_back(position.enPassantRow);
+    castlingRights.push_back(position.castlingRights);
+    sidesToMove.push_back(position.sideToMove);
+    halfmoveClocks.push_back(position.halfmoveClock);
+    middlegameScores.push_back(position.middlegameScore);
+    endgameScores.push_back(position.endgameScore);
+    phases.push_back(position.phase);
+}
+
+Position PositionBatch::get(std::size_t index) const {
+    Position position;
+    for (int type = 0; type < 7; type++) {
+        position.typeBB[type] = typeBB[type][index];
+    }
+    position.colorBB[0] = colorBB[0][index];
+    position.colorBB[1] = colorBB[1][index];
+    position.key = keys[index];
+    position.enPassantCol = enPassantCols[index];
+    position.enPassantRow = enPassantRows[index];
+    position.castlingRights = castlingRights[index];
+    position.sideToMove = sidesToMove[index];
+    position.halfmoveClock = halfmoveClocks[index];
+    position.middlegameScore = middlegameScores[index];
+    position.endgameScore = endgameScores[index];
+    position.phase = phases[index];
+
+    for (int color = 0; color < 2; color++) {
+        Bitboard king = position.typeBB[static_cast<int>(PieceType::KING)] & position.colorBB[color];
+        position.kingSquares[color] = static_cast<signed char>(king ? lsb(king) : -1);
+    }
+    return position;
+}
+
+void PositionBatch::clear() {
+    for (std::vector<Bitboard>& column : typeBB) {
+        column.clear();
+    }
+    colorBB[0].clear();
+    colorBB[1].clear();
+    keys.clear();
+    enPassantCols.clear();
+    enPassantRows.clear();
+    castlingRights.clear();
+    sidesToMove.clear();
+    halfmoveClocks.clear();
+    middlegameScores.clear();
+    endgameScores.clear();
+    phases.clear();
+}
+
+void PositionBatch::evaluateRange(std::size_t begin, std::size_t end, BatchStatus& status) const {
+    const Bitboard* occupied = typeBB[0].data();
+    const Bitboard* rooks = typeBB[static_cast<int>(PieceType::ROOK)].data();
+    const Bitboard* knights = typeBB[static_cast<int>(PieceType::KNIGHT)].data();
+    const Bitboard* bishops = typeBB[static_cast<int>(PieceType::BISHOP)].data();
+    const Bitboard* kings = typeBB[static_cast<int>(PieceType::KING)].data();
+    const Bitboard* queens = typeBB[static_cast<int>(PieceType::QUEEN)].data();
+    const Bitboard* pawns = typeBB[static_cast<int>(PieceType::PAWN)].data();
+    const Bitboard* whites = colorBB[0].data();
+    const Bitboard* blacks = colorBB[1].data();
+
+    // Sanity checks and check detection: straight-line 64-bit arithmetic on
+    // the columns, no branches, lookups or narrow types, so it vectorizes.
+    // The result is the set of kings in check, or every square if the
+    // placement is broken.
+    std::vector<Bitboard> checkedKings(end - begin);
+    Bitboard* checked = checkedKings.data();
+    for (std::size_t i = begin; i < end; i++) {
+        Bitboard white = whites[i];
+        Bitboard black = blacks[i];
+        Bitboard orthogonal = rooks[i] | queens[i];
+        Bitboard diagonal = bishops[i] | queens[i];
+        Bitboard whiteKing = kings[i] & white;
+        Bitboard blackKing = kings[i] & black;
+
+        bool consistent = singleSquare(whiteKing) & singleSquare(blackKing) &
+            ((white & black) == 0) & ((white | black) == occupied[i]) &
+            ((rooks[i] | knights[i] | bishops[i] | kings[i] | queens[i] | pawns[i]) == occupied[i]) &
+            ((pawns[i] & backRanks) == 0);
+
+        Bitboard byWhite = Attacks::slidingAttacksScalar(orthogonal & white, diagonal & white, occupied[i]) |
+            Attacks::knightSet(knights[i] & white) | Attacks::kingSet(whiteKing) |
+            Attacks::pawnSet(PieceColor::WHITE, pawns[i] & white);
+        Bitboard byBlack = Attacks::slidingAttacksScalar(orthogonal & black, diagonal & black, occupied[i]) |
+            Attacks::knightSet(knights[i] & black) | Attacks::kingSet(blackKing) |
+            Attacks::pawnSet(PieceColor::BLACK, pawns[i] & black);
+
+        checked[i - begin] = ((byBlack & whiteKing) | (byWhite & blackKing)) | (Bitboard(consistent) - 1);
+    }
+
+    // Side to move decides what a checked king means; the positions that
+    // pass get their legal moves counted
+    ChessBoard board;
+    MoveList moves;
+    for (std::size_t i = begin; i < end; i++) {
+        Bitboard own = sidesToMove[i] == PieceColor::WHITE ? whites[i] : blacks[i];
+        if (checked[i - begin] == ~Bitboard(0) || (checked[i - begin] & kings[i] & ~own)) {
+            status.state[i] = PositionState::ILLEGAL;
+            status.moveCount[i] = 0;
+            continue;
+        }
+
+        board.setPosition(get(i));
+        moves.clear();
+        board.generateLegalMoves(moves);
+        status.moveCount[i] = static_cast<std::uint16_t>(moves.size());
+
+        bool inCheck = (checked[i - begin] & kings[i] & own) != 0;
+        if (moves.size() == 0) {
+            status.state[i] = inCheck ? PositionState::CHECKMATE : PositionState::STALEMATE;
+        }
+        else {
+            status.state[i] = inCheck ? PositionState::CHECK : PositionState::PLAYING;
+        }
+    }
+}
+
+void PositionBatch::evaluate(BatchStatus& status, int threads) const {
+    std::size_t count = size();
+    status.state.resize(count);
+    status.moveCount.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    std::size_t workers = static_cast<std::size_t>(std::max(threads, 1));
+    workers = std::min(workers, count);
+    std::size_t chunk = (count + workers - 1) / workers;
+
+    std::vector<std::thread> pool;
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {
+        pool.emplace_back(&PositionBatch::evaluateRange, this, begin, std::min(begin + chunk, count), std::ref(status));
+    }
+    evaluateRange(0, std::min(chunk, count), status);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
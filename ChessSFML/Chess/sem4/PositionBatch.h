@@ -0,0 +1,112 @@
+/**
+ * @file PositionBatch.h
+ * @brief Status classification of many positions in one call
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * PositionBatch stores positions struct-of-arrays: one contiguous column
+ * per Position field. Sanity checks and check detection are branch-free
+ * bit arithmetic over these columns, so the compiler can vectorize them
+ * across positions. Only the positions that pass go on to move
+ * generation, which runs on one ChessBoard per thread that is pointed at
+ * each position in turn with ChessBoard::setPosition().
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Position.h"
+
+/**
+ * @brief Classification of one position in a batch
+ */
+enum class PositionState : std::uint8_t {
+    ILLEGAL,    ///< Broken placement, or the side that just moved is in check
+    PLAYING,    ///< Side to move has legal moves and is not in check
+    CHECK,      ///< Side to move is in check and has legal moves
+    CHECKMATE,  ///< Side to move is in check without a legal move
+    STALEMATE   ///< Side to move is not in check and has no legal move
+};
+
+/**
+ * @struct BatchStatus
+ * @brief Results of PositionBatch::evaluate(), one entry per position
+ */
+struct BatchStatus {
+    std::vector<PositionState> state;       ///< Classification of each position
+    std::vector<std::uint16_t> moveCount;   ///< Legal moves of the side to move (0 for illegal positions)
+};
+
+/**
+ * @class PositionBatch
+ * @brief Positions stored column by column for bulk classification
+ */
+class PositionBatch {
+private:
+    // Position fields, one column each; king squares are derived from typeBB
+    std::vector<Bitboard> typeBB[7];            ///< Position::typeBB columns
+    std::vector<Bitboard> colorBB[2];           ///< Position::colorBB columns
+    std::vector<std::uint64_t> keys;            ///< Position::key column
+    std::vector<signed char> enPassantCols;     ///< Position::enPassantCol column
+    std::vector<signed char> enPassantRows;     ///< Position::enPassantRow column
+    std::vector<std::uint8_t> castlingRights;   ///< Position::castlingRights column
+    std::vector<PieceColor> sidesToMove;        ///< Position::sideToMove column
+    std::vector<std::uint16_t> halfmoveClocks;  ///< Position::halfmoveClock column
+    std::vector<std::int16_t> middlegameScores; ///< Position::middlegameScore column
+    std::vector<std::int16_t> endgameScores;    ///< Position::endgameScore column
+    std::vector<std::uint8_t> phases;           ///< Position::phase column
+
+    /**
+     * @brief Classifies a contiguous range of positions
+     * @param begin First index
+     * @param end One past the last index
+     * @param status Results, already sized to the batch
+     */
+    void evaluateRange(std::size_t begin, std::size_t end, BatchStatus& status) const;
+
+public:
+    /**
+     * @brief Reserves room for a number of positions
+     * @param count Expected number of positions
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Appends a position
+     * @param position Position to store, e.g. from ChessBoard::getPosition()
+     */
+    void add(const Position& position);
+
+    /**
+     * @brief Reassembles a stored position
+     * @param index Index of the position
+     * @return Position as it was added
+     */
+    Position get(std::size_t index) const;
+
+    /**
+     * @brief Returns the number of positions
+     * @return Number of positions
+     */
+    std::size_t size() const { return keys.size(); }
+
+    /**
+     * @brief Removes every position, keeping the allocated memory
+     */
+    void clear();
+
+    /**
+     * @brief Classifies every position and counts its legal moves
+     *
+     * A position is illegal if a side does not have exactly one king, a
+     * pawn stands on the first or last row, the piece sets disagree with
+     * each other, or the side that is not to move is in check.
+     *
+     * Positions are split into contiguous ranges, one per thread.
+     *
+     * @param status Receives one entry per position
+     * @param threads Number of worker threads (values below 1 mean 1)
+     */
+    void evaluate(BatchStatus& status, int threads) const;
+};
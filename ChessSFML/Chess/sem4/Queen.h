@@ -8,8 +8,6 @@
  */
 #pragma once
 
-#include <vector>
-#include <SFML/System/Vector2.hpp>
 #include "Piece.h"
 
  // Forward declaration
@@ -31,22 +29,4 @@ public:
      * Initializes a Queen with the specified color and sets its type to QUEEN
      */
     Queen(PieceColor color);
-
-    /**
-     * @brief Calculate all possible moves for the Queen
-     *
-     * Determines all valid moves the Queen can make from its current position
-     * on the chess board, considering:
-     * - Movement along ranks (horizontal)
-     * - Movement along files (vertical)
-     * - Movement along diagonals
-     * - Blocking by other pieces
-     * - Board boundaries
-     *
-     * @param row Current row of the Queen
-     * @param col Current column of the Queen
-     * @param board Reference to the current chess board state
-     * @return std::vector<sf::Vector2i> List of possible move coordinates
-     */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const override;
 };
\ No newline at end of file
@@ -8,8 +8,6 @@
  */
 #pragma once
 
-#include <vector>
-#include <SFML/System/Vector2.hpp>
 #include "Piece.h"
 
  // Forward declaration
@@ -31,21 +29,4 @@ public:
      * Initializes a Rook with the specified color and sets its type to ROOK
      */
     Rook(PieceColor color);
-
-    /**
-     * @brief Calculate all possible moves for the Rook
-     *
-     * Determines all valid moves the Rook can make from its current position
-     * on the chess board, considering:
-     * - Movement along ranks (horizontal)
-     * - Movement along files (vertical)
-     * - Blocking by other pieces
-     * - Board boundaries
-     *
-     * @param row Current row of the Rook
-     * @param col Current column of the Rook
-     * @param board Reference to the current chess board state
-     * @return std::vector<sf::Vector2i> List of possible move coordinates
-     */
-    std::vector<sf::Vector2i> getPossibleMoves(int row, int col, const ChessBoard& board) const override;
 };
\ No newline at end of file
@@ -0,0 +1,442 @@
+#include "SearchWorker.h"
+#include "Engine.h"
+#include <thread>
+#include <utility>
+
+static_assert(Engine::MAX_DEPTH <= HistoryTables::MAX_PLY, "every ply of the search needs killer slots");
+
+namespace {
+    /// Nodes between two looks at the clock (a power of two)
+    const std::uint64_t clockInterval = 2048;
+
+    /// Scores at least this far from zero are mates
+    const int MATE_BOUND = Engine::MATE_SCORE - Engine::MAX_DEPTH;
+
+    /**
+     * @brief Converts a mate score from distance-to-root to distance-to-position
+     *
+     * The table is shared between searches and plies, so a stored mate
+     * score counts plies from the stored position, not from the root.
+     */
+    int scoreToTable(int score, int ply) {
+        return score >= MATE_BOUND ? score + ply : score <= -MATE_BOUND ? score - ply : score;
+    }
+
+    /**
+     * @brief Converts a stored mate score back to distance-to-root
+     */
+    int scoreFromTable(int score, int ply) {
+        return score >= MATE_BOUND ? score - ply : score <= -MATE_BOUND ? score + ply : score;
+    }
+}
+
+SearchWorker::SearchWorker(SearchShared& searchShared, int workerIndex) : shared(searchShared), index(workerIndex),
+    activeSplit(nullptr), stealDepth(0), nodes(0), hashProbes(0), hashHits(0), cutoffs(0), firstMoveCutoffs(0),
+    publishedNodes(0), publishedHashProbes(0), publishedHashHits(0), publishedCutoffs(0), publishedFirstMoveCutoffs(0),
+    completedDepth(0), completedScore(0), completedMove(Move::none()) {
+}
+
+void SearchWorker::prepare(const ChessBoard& position) {
+    board = position;
+    activeSplit = nullptr;
+    tables.clear();
+    nodes = 0;
+    hashProbes = 0;
+    hashHits = 0;
+    cutoffs = 0;
+    firstMoveCutoffs = 0;
+    publish();
+    completedDepth = 0;
+    completedScore = 0;
+    completedMove = Move::none();
+}
+
+void SearchWorker::publish() {
+    publishedNodes.store(nodes, std::memory_order_relaxed);
+    publishedHashProbes.store(hashProbes, std::memory_order_relaxed);
+    publishedHashHits.store(hashHits, std::memory_order_relaxed);
+    publishedCutoffs.store(cutoffs, std::memory_order_relaxed);
+    publishedFirstMoveCutoffs.store(firstMoveCutoffs, std::memory_order_relaxed);
+}
+
+void SearchWorker::runHelper(int firstDepth) {
+    Move best = Move::none();
+    for (int depth = firstDepth; depth <= shared.limits.maxDepth && depth <= Engine::MAX_DEPTH; depth++) {
+        Move iterationBest = Move::none();
+        searchRoot(depth, best, iterationBest);
+        if (shared.stop.load(std::memory_order_relaxed)) {
+            break;
+        }
+        best = iterationBest;
+    }
+    publish();
+}
+
+void SearchWorker::runStealer() {
+    SplitTask task;
+    while (!shared.stop.load(std::memory_order_relaxed)) {
+        if (stealTask(nullptr, task)) {
+            runTask(task, true);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    publish();
+}
+
+int SearchWorker::searchRoot(int depth, Move previousBest, Move& bestMove) {
+    nodes++;
+    MoveList moves;
+    MovePicker picker(board, previousBest, tables, 0);
+    for (Move move = picker.next(); !move.isNone(); move = picker.next()) {
+        moves.add(move);
+    }
+
+    int alpha = -Engine::INFINITE_SCORE;
+    bestMove = moves[0];
+    for (const Move& move : moves) {
+        board.makeLegalMove(move);
+        int score = -negamax(depth - 1, 1, -Engine::INFINITE_SCORE, -alpha);
+        board.unmakeMove();
+
+        if (shared.stop.load(std::memory_order_relaxed)) {
+            break;
+        }
+        if (score > alpha) {
+            alpha = score;
+            bestMove = move;
+        }
+    }
+
+    publish();
+    if (!aborted() && depth > completedDepth) {
+        completedDepth = depth;
+        completedScore = alpha;
+        completedMove = bestMove;
+    }
+    return alpha;
+}
+
+int SearchWorker::negamax(int depth, int ply, int alpha, int beta) {
+    nodes++;
+    if (shouldStop()) {
+        return 0;
+    }
+
+    if (board.getRepetitionCount() > 0 || board.hasInsufficientMaterial()) {
+        return 0;
+    }
+
+    // Checkmate beats the fifty-move rule, so a checked side is searched
+    // on and the draw scored after the moves. Without a check there is no
+    // mate to find, and the draw is scored right away
+    bool fiftyMoveDraw = board.isFiftyMoveDraw();
+    if (fiftyMoveDraw) {
+        PieceColor side = board.getSideToMove();
+        PieceColor opponent = side == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
+        if (!board.isSquareAttacked(board.getKingSquare(side), opponent)) {
+            return 0;
+        }
+    }
+    if (ply >= Engine::MAX_DEPTH) {
+        return Engine::evaluate(board);
+    }
+    if (depth <= 0) {
+        return quiescence(ply, alpha, beta);
+    }
+
+    TranspositionTable& table = *shared.table;
+    std::uint64_t key = board.getKey();
+    Move hashMove = Move::none();
+    TTEntry entry;
+    hashProbes++;
+    if (table.probe(key, entry)) {
+        hashHits++;
+        hashMove = entry.move;
+        if (entry.depth >= depth) {
+            int score = scoreFromTable(entry.score, ply);
+            if (entry.bound == TTBound::EXACT ||
+                (entry.bound == TTBound::LOWER && score >= beta) ||
+                (entry.bound == TTBound::UPPER && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    int alphaOriginal = alpha;
+    int bestScore = -Engine::INFINITE_SCORE;
+    Move bestMove = Move::none();
+    int moveCount = 0;
+    Move quietsTried[MoveList::CAPACITY];
+    int quietCount = 0;
+    MovePicker picker(board, hashMove, tables, ply);
+    for (Move move = picker.next(); !move.isNone(); move = picker.next()) {
+        // Young Brothers Wait: the younger moves are shared only once the
+        // eldest has been searched without a cutoff
+        if (moveCount == 1 && canSplit(depth)) {
+            MoveList rest;
+            for (; !move.isNone(); move = picker.next()) {
+                rest.add(move);
+            }
+            moveCount += rest.size();
+            searchSplit(rest, 0, depth, ply, alpha, beta, bestScore, bestMove, quietsTried, quietCount);
+            break;
+        }
+
+        bool quiet = !move.isPromotion() && !board.isCapture(move);
+        moveCount++;
+        board.makeLegalMove(move);
+        int score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        board.unmakeMove();
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+        if (quiet) {
+            quietsTried[quietCount++] = move;
+        }
+    }
+
+    if (moveCount == 0) {
+        PieceColor side = board.getSideToMove();
+        PieceColor opponent = side == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
+        bool inCheck = board.isSquareAttacked(board.getKingSquare(side), opponent);
+        return inCheck ? -(Engine::MATE_SCORE - ply) : 0;
+    }
+    if (fiftyMoveDraw) {
+        return 0;
+    }
+
+    // Scores of an interrupted search are not trustworthy
+    if (!aborted()) {
+        if (bestScore >= beta) {
+            cutoffs++;
+            firstMoveCutoffs += moveCount == 1;
+            if (!bestMove.isPromotion() && !board.isCapture(bestMove)) {
+                tables.recordCutoff(board.getSideToMove(), ply, depth, board.getLastMove(), bestMove, quietsTried, quietCount);
+            }
+        }
+
+        TTBound bound = bestScore >= beta ? TTBound::LOWER : bestScore > alphaOriginal ? TTBound::EXACT : TTBound::UPPER;
+        table.store(key, bound == TTBound::UPPER ? Move::none() : bestMove, scoreToTable(bestScore, ply), depth, bound);
+    }
+    return bestScore;
+}
+
+int SearchWorker::quiescence(int ply, int alpha, int beta) {
+    nodes++;
+    if (shouldStop()) {
+        return 0;
+    }
+    if (ply >= Engine::MAX_DEPTH) {
+        return Engine::evaluate(board);
+    }
+
+    PieceColor side = board.getSideToMove();
+    PieceColor opponent = side == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
+    bool inCheck = board.isSquareAttacked(board.getKingSquare(side), opponent);
+
+    int bestScore = -Engine::INFINITE_SCORE;
+    if (!inCheck) {
+        bestScore = Engine::evaluate(board);
+        if (bestScore >= beta) {
+            return bestScore;
+        }
+        if (bestScore > alpha) {
+            alpha = bestScore;
+        }
+    }
+
+    int moveCount = 0;
+    MovePicker picker = inCheck ? MovePicker(board, Move::none(), tables, ply) : MovePicker(board, tables);
+    for (Move move = picker.next(); !move.isNone(); move = picker.next()) {
+        moveCount++;
+        board.makeLegalMove(move);
+        int score = -quiescence(ply + 1, -beta, -alpha);
+        board.unmakeMove();
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (inCheck && moveCount == 0) {
+        return -(Engine::MATE_SCORE - ply);
+    }
+    return bestScore;
+}
+
+bool SearchWorker::aborted() const {
+    if (shared.stop.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    for (const SplitPoint* split = activeSplit; split != nullptr; split = split->parent) {
+        if (split->cutoff.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SearchWorker::canSplit(int depth) const {
+    return shared.mode == ParallelMode::YBWC && shared.workers.size() > 1 && depth >= MIN_SPLIT_DEPTH && !aborted();
+}
+
+void SearchWorker::searchSplit(const MoveList& moves, int first, int depth, int ply, int& alpha, int beta,
+    int& bestScore, Move& bestMove, Move* quietsTried, int& quietCount) {
+    SplitPoint split;
+    split.position = board.getPosition();
+    split.keyCount = board.getRepetitionKeys(split.keys, SplitPoint::MAX_KEYS);
+    split.parent = activeSplit;
+    split.depth = depth;
+    split.ply = ply;
+    split.beta = beta;
+    split.alpha = alpha;
+    split.bestScore = bestScore;
+    split.bestMove = bestMove;
+    split.quietCount = 0;
+    split.cutoff.store(false, std::memory_order_relaxed);
+    split.pending.store(moves.size() - first, std::memory_order_relaxed);
+
+    // Pushed worst first, so the owner takes the best move from the back
+    // and thieves take the worst from the front
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        for (int i = moves.size() - 1; i >= first; i--) {
+            tasks.push_back({ &split, moves[i] });
+        }
+    }
+
+    SplitTask task;
+    while (popTask(&split, task)) {
+        runTask(task, false);
+    }
+
+    // Thieves are still searching some moves. Rather than sit idle, help
+    // with the split points they opened below this one
+    while (split.pending.load(std::memory_order_acquire) > 0) {
+        if (stealTask(&split, task)) {
+            runTask(task, true);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(split.mutex);
+    alpha = split.alpha;
+    bestScore = split.bestScore;
+    bestMove = split.bestMove;
+    for (int i = 0; i < split.quietCount; i++) {
+        quietsTried[quietCount++] = split.quietsTried[i];
+    }
+}
+
+void SearchWorker::runTask(const SplitTask& task, bool stolen) {
+    SplitPoint& split = *task.split;
+    if (!split.cutoff.load(std::memory_order_relaxed)) {
+        if (stolen) {
+            if (stealDepth == static_cast<int>(spareBoards.size())) {
+                spareBoards.emplace_back();
+            }
+            std::swap(board, spareBoards[stealDepth++]);
+            board.setPosition(split.position, split.keys, split.keyCount);
+        }
+        int alpha;
+        {
+            std::lock_guard<std::mutex> lock(split.mutex);
+            alpha = split.alpha;
+        }
+
+        bool quiet = !task.move.isPromotion() && !board.isCapture(task.move);
+        SplitPoint* outer = activeSplit;
+        activeSplit = &split;
+        board.makeLegalMove(task.move);
+        int score = -negamax(split.depth - 1, split.ply + 1, -split.beta, -alpha);
+        board.unmakeMove();
+        bool discard = aborted();
+        activeSplit = outer;
+        if (stolen) {
+            std::swap(board, spareBoards[--stealDepth]);
+        }
+
+        if (!discard) {
+            std::lock_guard<std::mutex> lock(split.mutex);
+            if (score > split.bestScore) {
+                split.bestScore = score;
+                split.bestMove = task.move;
+                if (score > split.alpha) {
+                    split.alpha = score;
+                    if (score >= split.beta) {
+                        split.cutoff.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+            if (quiet && score < split.beta) {
+                split.quietsTried[split.quietCount++] = task.move;
+            }
+        }
+    }
+    split.pending.fetch_sub(1, std::memory_order_release);
+}
+
+bool SearchWorker::popTask(SplitPoint* split, SplitTask& task) {
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    if (tasks.empty() || tasks.back().split != split) {
+        return false;
+    }
+    task = tasks.back();
+    tasks.pop_back();
+    return true;
+}
+
+bool SearchWorker::stealTask(const SplitPoint* ancestor, SplitTask& task) {
+    int count = static_cast<int>(shared.workers.size());
+    for (int offset = 1; offset < count; offset++) {
+        SearchWorker& victim = *shared.workers[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.tasksMutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+
+        // Split points on the victim's stack stay alive while their tasks
+        // are queued, so the chain can be walked under the lock
+        const SplitTask& oldest = victim.tasks.front();
+        bool below = ancestor == nullptr;
+        for (const SplitPoint* split = oldest.split->parent; split != nullptr && !below; split = split->parent) {
+            below = split == ancestor;
+        }
+        if (below) {
+            task = oldest;
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SearchWorker::shouldStop() {
+    if ((nodes & (clockInterval - 1)) == 0) {
+        publish();
+        const SearchLimits& limits = shared.limits;
+        if (limits.moveTimeMs > 0 &&
+            std::chrono::steady_clock::now() - shared.startTime >= std::chrono::milliseconds(limits.moveTimeMs)) {
+            shared.stop.store(true, std::memory_order_relaxed);
+        }
+    }
+    return shared.stop.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,341 @@
+/**
+ * @file SearchWorker.h
+ * @brief One thread's share of an engine search
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * A SearchWorker owns everything a search thread writes while it runs:
+ * its copy of the position, its move ordering statistics and its
+ * counters. What the threads share
+ * lives in SearchShared: the transposition table, the stop flag, the
+ * limits and the start time.
+ *
+ * Workers can cooperate in two ways (ParallelMode). In Lazy SMP they only
+ * share the table and never wait on each other. In YBWC (Young Brothers
+ * Wait Concept) a node that has searched its eldest move without a cutoff
+ * becomes a split point: its remaining moves go as tasks to the back of
+ * its worker's deque, the worker takes them back one by one from there,
+ * and idle workers steal from the front, where the tasks of the split
+ * points nearest the root, and so the biggest subtrees, are waiting.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "ChessBoard.h"
+#include "MovePicker.h"
+#include "TranspositionTable.h"
+
+/**
+ * @struct SearchLimits
+ * @brief When a search stops
+ */
+struct SearchLimits {
+    int maxDepth;    ///< Deepest iteration in plies
+    int moveTimeMs;  ///< Time budget in milliseconds, 0 for no limit
+};
+
+/**
+ * @enum ParallelMode
+ * @brief How the workers of one search divide the work
+ */
+enum class ParallelMode {
+    LAZY_SMP,  ///< Every worker searches the whole tree; they share the table only
+    YBWC       ///< Workers steal the younger moves of each other's nodes
+};
+
+class SearchWorker;
+
+/**
+ * @struct SearchShared
+ * @brief State shared by every worker of one search
+ */
+struct SearchShared {
+    TranspositionTable* table;                         ///< Table every worker reads and writes
+    std::atomic<bool> stop;                            ///< Set to make every worker return
+    SearchLimits limits;                               ///< Limits of the running search
+    std::chrono::steady_clock::time_point startTime;   ///< When the running search started
+    ParallelMode mode;                                 ///< How the workers divide the work
+    std::vector<SearchWorker*> workers;                ///< Every worker, for stealing
+};
+
+/**
+ * @struct SplitPoint
+ * @brief Node whose remaining moves are searched by several workers
+ *
+ * Lives on the stack of the worker that split, which does not return
+ * until every task of the split point has finished.
+ */
+struct SplitPoint {
+    /**
+     * @brief Earlier position keys kept for repetition detection
+     *
+     * Only positions since the last capture or pawn move can repeat, and
+     * after a hundred plies of those the fifty-move rule applies.
+     */
+    static const int MAX_KEYS = 128;
+
+    Position position;               ///< Position at the node, loaded by the workers that steal
+    std::uint64_t keys[MAX_KEYS];    ///< Keys of the earlier positions a repetition can match, oldest first
+    int keyCount;                    ///< Entries in keys
+    SplitPoint* parent;        ///< Split point the owner was working under, nullptr if none
+    int depth;                 ///< Remaining depth at the node
+    int ply;                   ///< Distance of the node from the root
+    int beta;                  ///< Upper bound of the window
+
+    std::mutex mutex;          ///< Guards alpha, bestScore, bestMove and the quiet moves
+    int alpha;                 ///< Lower bound of the window, raised by every worker
+    int bestScore;             ///< Best score found so far
+    Move bestMove;             ///< Move with bestScore
+    Move quietsTried[MoveList::CAPACITY];  ///< Quiet moves searched without a cutoff, for the history malus
+    int quietCount;                        ///< Entries in quietsTried
+
+    std::atomic<bool> cutoff;  ///< Set once a move fails high; the other tasks are abandoned
+    std::atomic<int> pending;  ///< Tasks queued or being searched
+};
+
+/**
+ * @struct SplitTask
+ * @brief One move of a split point, as queued in a worker's deque
+ */
+struct SplitTask {
+    SplitPoint* split;  ///< Node the move is played from
+    Move move;          ///< Move to search
+};
+
+/**
+ * @class SearchWorker
+ * @brief Alpha-beta search over a private copy of the position
+ */
+class SearchWorker {
+private:
+    SearchShared& shared;  ///< State shared with the other workers
+    int index;             ///< Position of the worker in shared.workers
+    ChessBoard board;      ///< Private copy of the root position
+    HistoryTables tables;  ///< Killers, counter-moves and history of this thread
+
+    SplitPoint* activeSplit;      ///< Innermost split point the worker is searching under, nullptr if none
+    std::deque<SplitTask> tasks;  ///< Tasks of the worker's split points, youngest at the back
+    std::mutex tasksMutex;        ///< Guards tasks against thieves
+
+    /**
+     * @brief Boards set aside while the worker searches stolen tasks, one per nesting level
+     *
+     * A stolen task is searched on a board swapped in from here, so the
+     * board of the search it interrupts is swapped back untouched.
+     */
+    std::vector<ChessBoard> spareBoards;
+    int stealDepth;               ///< Stolen tasks the worker is nested in
+
+    // Counters, written only by the worker's own thread
+    std::uint64_t nodes;       ///< Positions visited
+    std::uint64_t hashProbes;  ///< Table lookups
+    std::uint64_t hashHits;    ///< Table lookups that found an entry
+    std::uint64_t cutoffs;     ///< Nodes that failed high
+    std::uint64_t firstMoveCutoffs;  ///< Nodes that failed high on the first move searched
+
+    // Counters as last published for other threads to read
+    std::atomic<std::uint64_t> publishedNodes;       ///< Copy of nodes
+    std::atomic<std::uint64_t> publishedHashProbes;  ///< Copy of hashProbes
+    std::atomic<std::uint64_t> publishedHashHits;    ///< Copy of hashHits
+    std::atomic<std::uint64_t> publishedCutoffs;     ///< Copy of cutoffs
+    std::atomic<std::uint64_t> publishedFirstMoveCutoffs;  ///< Copy of firstMoveCutoffs
+
+    // Result of the deepest iteration this worker finished
+    int completedDepth;  ///< Depth, 0 before the first iteration
+    int completedScore;  ///< Score of completedMove
+    Move completedMove;  ///< Best move
+
+    /// Nodes with less remaining depth are searched by one worker alone
+    static const int MIN_SPLIT_DEPTH = 4;
+
+    /**
+     * @brief Negamax alpha-beta search below the root
+     * @param depth Remaining depth in plies
+     * @param ply Distance from the root
+     * @param alpha Lower bound of the window
+     * @param beta Upper bound of the window
+     * @return Score for the side to move; at most alpha if every move
+     *         fails low, at least beta after a cutoff
+     */
+    int negamax(int depth, int ply, int alpha, int beta);
+
+    /**
+     * @brief Searches captures only until the position is quiet
+     *
+     * The side to move may stand pat on the static evaluation instead of
+     * capturing, unless it is in check, when every evasion is searched.
+     * Captures that lose material by static exchange are skipped.
+     *
+     * @param ply Distance from the root
+     * @param alpha Lower bound of the window
+     * @param beta Upper bound of the window
+     * @return Score for the side to move, fail-soft like negamax()
+     */
+    int quiescence(int ply, int alpha, int beta);
+
+    /**
+     * @brief Checks the clock and publishes the counters every few thousand nodes
+     * @return true if the search must stop
+     */
+    bool shouldStop();
+
+    /**
+     * @brief Tells whether the current search result must be thrown away
+     * @return true if the search was stopped or a split point above failed high
+     */
+    bool aborted() const;
+
+    /**
+     * @brief Tells whether a node may split
+     * @param depth Remaining depth of the node
+     * @return true in YBWC mode for nodes deep enough to be worth sharing
+     */
+    bool canSplit(int depth) const;
+
+    /**
+     * @brief Searches the moves of a node from a given index on together with idle workers
+     *
+     * Returns once every move has been searched or one failed high.
+     *
+     * @param moves Moves of the node, ordered
+     * @param first Index of the first move still to search
+     * @param depth Remaining depth of the node
+     * @param ply Distance of the node from the root
+     * @param alpha Lower bound of the window; raised to the split point's final alpha
+     * @param beta Upper bound of the window
+     * @param bestScore Best score so far; updated
+     * @param bestMove Move with bestScore; updated
+     * @param quietsTried Quiet moves searched without a cutoff; those of the split are appended
+     * @param quietCount Entries in quietsTried; updated
+     */
+    void searchSplit(const MoveList& moves, int first, int depth, int ply, int& alpha, int beta,
+        int& bestScore, Move& bestMove, Move* quietsTried, int& quietCount);
+
+    /**
+     * @brief Searches one task and records its score in the split point
+     * @param task Task to search
+     * @param stolen true if the board is not at the split point's position, and must be left as it is
+     */
+    void runTask(const SplitTask& task, bool stolen);
+
+    /**
+     * @brief Takes the youngest task of a split point back from the worker's own deque
+     * @param split Split point whose task is wanted
+     * @param task Receives the task
+     * @return true if the back of the deque held a task of split
+     */
+    bool popTask(SplitPoint* split, SplitTask& task);
+
+    /**
+     * @brief Steals the oldest task from another worker's deque
+     * @param ancestor Only steal tasks of split points below this one, nullptr for any task
+     * @param task Receives the task
+     * @return true if a task was stolen
+     */
+    bool stealTask(const SplitPoint* ancestor, SplitTask& task);
+
+public:
+    /**
+     * @brief Constructor
+     * @param searchShared State shared with the other workers of the engine
+     * @param workerIndex Position of the worker in searchShared.workers
+     */
+    SearchWorker(SearchShared& searchShared, int workerIndex);
+
+    /**
+     * @brief Copies the root position and clears the statistics, counters and result
+     * @param position Position to search
+     */
+    void prepare(const ChessBoard& position);
+
+    /**
+     * @brief Searches the root position to one depth
+     *
+     * A finished iteration becomes the worker's completed result.
+     *
+     * @param depth Depth in plies
+     * @param previousBest Move to try first, Move::none() for none
+     * @param bestMove Receives the best move found
+     * @return Score of the best move, meaningless if the search was stopped
+     */
+    int searchRoot(int depth, Move previousBest, Move& bestMove);
+
+    /**
+     * @brief Runs iterative deepening until the search is stopped
+     *
+     * Used by the helper threads. Starting helpers at different depths
+     * spreads them over different parts of the tree from the first
+     * iteration on.
+     *
+     * @param firstDepth Depth of the first iteration
+     */
+    void runHelper(int firstDepth);
+
+    /**
+     * @brief Steals and searches tasks of the other workers until the search is stopped
+     *
+     * Used by the helper threads in YBWC mode.
+     */
+    void runStealer();
+
+    /**
+     * @brief Makes the counters visible to other threads
+     */
+    void publish();
+
+    /**
+     * @brief Returns the last published node count; safe from any thread
+     * @return Positions visited
+     */
+    std::uint64_t getNodes() const { return publishedNodes.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the last published table lookup count; safe from any thread
+     * @return Table lookups
+     */
+    std::uint64_t getHashProbes() const { return publishedHashProbes.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the last published table hit count; safe from any thread
+     * @return Table lookups that found an entry
+     */
+    std::uint64_t getHashHits() const { return publishedHashHits.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the last published fail-high count; safe from any thread
+     * @return Nodes that failed high
+     */
+    std::uint64_t getCutoffs() const { return publishedCutoffs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the last published first-move fail-high count; safe from any thread
+     * @return Nodes that failed high on the first move searched
+     */
+    std::uint64_t getFirstMoveCutoffs() const { return publishedFirstMoveCutoffs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the depth of the deepest finished iteration
+     *
+     * Read only once the worker's thread has been joined.
+     *
+     * @return Depth in plies, 0 before the first iteration
+     */
+    int getCompletedDepth() const { return completedDepth; }
+
+    /**
+     * @brief Returns the score of the deepest finished iteration
+     * @return Score for the side to move
+     */
+    int getCompletedScore() const { return completedScore; }
+
+    /**
+     * @brief Returns the best move of the deepest finished iteration
+     * @return Best move, Move::none() before the first iteration
+     */
+    Move getCompletedMove() const { return completedMove; }
+};
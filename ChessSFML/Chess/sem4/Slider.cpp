@@ -40,6 +40,14 @@ int Slider::updateValue(sf::Vector2i mousePos) {
     return currentValue;
 }
 
+void Slider::setValue(int value) {
+    currentValue = std::max(minValue, std::min(value, maxValue));
+
+    float percent = maxValue > minValue ? static_cast<float>(currentValue - minValue) / (maxValue - minValue) : 1.0f;
+    float x = track.getPosition().x + percent * track.getSize().x - handle.getSize().x / 2;
+    handle.setPosition(x, handle.getPosition().y);
+}
+
 int Slider::getValue() const {
     return currentValue;
 }
@@ -96,6 +96,12 @@ public:
      */
     int getValue() const;
 
+    /**
+     * @brief Sets the value and moves the handle to match
+     * @param value New value, clamped to the slider range
+     */
+    void setValue(int value);
+
     /**
      * @brief Checks if the slider is currently being dragged
      * @return true if the slider is being dragged, false otherwise
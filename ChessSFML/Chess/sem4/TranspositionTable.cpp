@@ -0,0 +1,118 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+
+namespace {
+    // Layout of Slot::data
+    const int SCORE_SHIFT = 16;       ///< Bits 16-31: score as a 16-bit signed value
+    const int DEPTH_SHIFT = 32;       ///< Bits 32-39: depth
+    const int BOUND_SHIFT = 40;       ///< Bits 40-41: TTBound (never NONE in a filled entry)
+    const int GENERATION_SHIFT = 42;  ///< Bits 42-47: generation of the search that wrote it
+
+    /**
+     * @brief Packs an entry into one word
+     * @return Packed data, never 0
+     */
+    std::uint64_t pack(Move move, int score, int depth, TTBound bound, std::uint8_t generation) {
+        return std::uint64_t(move.data) |
+            std::uint64_t(static_cast<std::uint16_t>(score)) << SCORE_SHIFT |
+            std::uint64_t(static_cast<std::uint8_t>(std::max(0, std::min(depth, 255)))) << DEPTH_SHIFT |
+            std::uint64_t(static_cast<std::uint8_t>(bound)) << BOUND_SHIFT |
+            std::uint64_t(generation) << GENERATION_SHIFT;
+    }
+
+    /// Depth stored in packed data
+    int depthOf(std::uint64_t data) { return static_cast<int>((data >> DEPTH_SHIFT) & 0xFF); }
+
+    /// Generation stored in packed data
+    int generationOf(std::uint64_t data) { return static_cast<int>((data >> GENERATION_SHIFT) & 63); }
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) : mask(0), generation(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    megabytes = std::max<std::size_t>(1, std::min<std::size_t>(megabytes, MAX_SIZE_MB));
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+        count *= 2;
+    }
+
+    // Buckets hold atomics, which cannot be moved, so the storage is
+    // replaced rather than resized
+    std::vector<Bucket> fresh(count);
+    buckets.swap(fresh);
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (Bucket& bucket : buckets) {
+        for (Slot& slot : bucket.slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+bool TranspositionTable::probe(std::uint64_t key, TTEntry& entry) const {
+    const Bucket& bucket = buckets[key & mask];
+    for (const Slot& slot : bucket.slots) {
+        std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data == 0 || (slot.check.load(std::memory_order_relaxed) ^ data) != key) {
+            continue;
+        }
+
+        entry.move.data = static_cast<std::uint16_t>(data);
+        entry.score = static_cast<std::int16_t>(data >> SCORE_SHIFT);
+        entry.depth = depthOf(data);
+        entry.bound = static_cast<TTBound>((data >> BOUND_SHIFT) & 3);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, Move move, int score, int depth, TTBound bound) {
+    Bucket& bucket = buckets[key & mask];
+    Slot* target = &bucket.slots[0];
+    int worst = 1 << 30;
+    for (Slot& slot : bucket.slots) {
+        std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data == 0) {
+            target = &slot;
+            break;
+        }
+        if ((slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+            if (move.isNone()) {
+                move.data = static_cast<std::uint16_t>(data);
+            }
+            target = &slot;
+            break;
+        }
+
+        // Each generation of age counts as much as eight plies of depth
+        int value = depthOf(data) - 8 * ((generation - generationOf(data)) & 63);
+        if (value < worst) {
+            worst = value;
+            target = &slot;
+        }
+    }
+
+    std::uint64_t data = pack(move, score, depth, bound, generation);
+    target->check.store(key ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::getUsagePermille() const {
+    int filled = 0;
+    int sampled = 0;
+    for (std::size_t i = 0; i < buckets.size() && sampled < 1000; i++) {
+        for (const Slot& slot : buckets[i].slots) {
+            std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+            filled += data != 0 && generationOf(data) == generation;
+            sampled++;
+        }
+    }
+    return sampled > 0 ? filled * 1000 / sampled : 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file TranspositionTable.h
+ * @brief Shared store of search results keyed by position
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * The same position is reached through many move orders, and the table
+ * lets the search reuse what it found the first time: a bound on the
+ * score, the depth it was searched to and the best move.
+ *
+ * Entries sit in 64-byte buckets of four, one cache line each, picked by
+ * the low bits of the Zobrist key. An entry is two 64-bit words written
+ * without locks: the packed data and the key XORed with that data. A
+ * reader recomputes the key from the pair, so an entry torn by two
+ * threads writing at once fails the check and reads as a miss instead of
+ * returning another position's data. Any number of search threads can
+ * share one table without a mutex.
+ *
+ * Every search starts a new generation. Entries from earlier searches of
+ * the game stay usable but are the first to be replaced.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Move.h"
+
+/**
+ * @enum TTBound
+ * @brief How a stored score relates to the true score
+ */
+enum class TTBound : std::uint8_t {
+    NONE = 0,   ///< Empty entry
+    UPPER = 1,  ///< Every move failed low; the true score is at most the stored one
+    LOWER = 2,  ///< A move failed high; the true score is at least the stored one
+    EXACT = 3   ///< The stored score is the true score
+};
+
+/**
+ * @struct TTEntry
+ * @brief Unpacked contents of a table entry
+ */
+struct TTEntry {
+    Move move;      ///< Best move found, Move::none() if there was none
+    int score;      ///< Score for the side to move (mates relative to the stored position)
+    int depth;      ///< Remaining depth the score was searched with
+    TTBound bound;  ///< How score relates to the true score
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Lock-free hash table of search results
+ */
+class TranspositionTable {
+private:
+    /**
+     * @struct Slot
+     * @brief One entry as stored: data and the key XORed with it
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> check;  ///< Key XOR data
+        std::atomic<std::uint64_t> data;   ///< Packed TTEntry and generation, 0 when empty
+    };
+
+    static const int BUCKET_SIZE = 4;  ///< Entries per bucket
+
+    /**
+     * @struct Bucket
+     * @brief Entries sharing one cache line
+     */
+    struct alignas(64) Bucket {
+        Slot slots[BUCKET_SIZE];  ///< Entries of the bucket
+    };
+
+    std::vector<Bucket> buckets;  ///< Table storage, a power of two in length
+    std::uint64_t mask;           ///< Bucket count minus one
+    std::uint8_t generation;      ///< Generation of the current search (6 bits)
+
+public:
+    static const int MAX_SIZE_MB = 4096;  ///< Largest size accepted by resize()
+
+    /**
+     * @brief Constructor
+     * @param megabytes Table size, see resize()
+     */
+    explicit TranspositionTable(std::size_t megabytes = 16);
+
+    /**
+     * @brief Reallocates the table, dropping every entry
+     *
+     * The bucket count is rounded down to a power of two, so the table
+     * takes at most the given size.
+     *
+     * @param megabytes Size in megabytes (1 to MAX_SIZE_MB)
+     */
+    void resize(std::size_t megabytes);
+
+    /**
+     * @brief Returns the table size
+     * @return Size in megabytes
+     */
+    std::size_t getSizeMB() const { return buckets.size() * sizeof(Bucket) / (1024 * 1024); }
+
+    /**
+     * @brief Empties every entry, e.g. for a new game
+     *
+     * Must not run while a search uses the table.
+     */
+    void clear();
+
+    /**
+     * @brief Starts a new generation; call once before every search
+     */
+    void newSearch() { generation = (generation + 1) & 63; }
+
+    /**
+     * @brief Looks a position up
+     * @param key Zobrist key of the position
+     * @param entry Receives the entry if one is found
+     * @return true if the table holds an entry for the key
+     */
+    bool probe(std::uint64_t key, TTEntry& entry) const;
+
+    /**
+     * @brief Stores a search result
+     *
+     * The entry for the same key is overwritten; otherwise an empty entry
+     * or the one that is shallowest after aging is replaced. Storing
+     * without a move keeps the move already stored for the key.
+     *
+     * @param key Zobrist key of the position
+     * @param move Best move, Move::none() if unknown
+     * @param score Score for the side to move, mates relative to this position
+     * @param depth Remaining depth of the search
+     * @param bound How score relates to the true score
+     */
+    void store(std::uint64_t key, Move move, int score, int depth, TTBound bound);
+
+    /**
+     * @brief Estimates how full the table is
+     *
+     * Samples the first thousand entries and counts those written in the
+     * current generation.
+     *
+     * @return Filled entries per thousand
+     */
+    int getUsagePermille() const;
+};
@@ -0,0 +1,53 @@
+#include "Zobrist.h"
+#include <mutex>
+
+std::uint64_t Zobrist::pieceKeys[16][64];
+std::uint64_t Zobrist::castlingKeys[16];
+std::uint64_t Zobrist::enPassantKeys[8];
+std::uint64_t Zobrist::sideKey;
+
+/**
+ * @brief SplitMix64 step, used to derive the keys from a fixed seed
+ * @param state Generator state, advanced by the call
+ * @return Next pseudo-random 64-bit value
+ */
+static std::uint64_t nextKey(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void Zobrist::init() {
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        std::uint64_t state = 0x43686573734B6579ULL;
+
+        for (int code = 0; code < 16; code++) {
+            int type = static_cast<int>(codeType(static_cast<PieceCode>(code)));
+            bool isPiece = type >= static_cast<int>(PieceType::ROOK) && type <= static_cast<int>(PieceType::PAWN);
+            for (int square = 0; square < 64; square++) {
+                pieceKeys[code][square] = isPiece ? nextKey(state) : 0;
+            }
+        }
+
+        // Each right has its own key; a combination is the XOR of its rights
+        std::uint64_t rightKeys[4];
+        for (std::uint64_t& rightKey : rightKeys) {
+            rightKey = nextKey(state);
+        }
+        for (int rights = 0; rights < 16; rights++) {
+            castlingKeys[rights] = 0;
+            for (int bit = 0; bit < 4; bit++) {
+                if (rights & (1 << bit)) {
+                    castlingKeys[rights] ^= rightKeys[bit];
+                }
+            }
+        }
+
+        for (std::uint64_t& enPassantKey : enPassantKeys) {
+            enPassantKey = nextKey(state);
+        }
+        sideKey = nextKey(state);
+    });
+}
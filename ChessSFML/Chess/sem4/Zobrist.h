@@ -0,0 +1,65 @@
+/**
+ * @file Zobrist.h
+ * @brief Random keys for hashing chess positions
+ * @author Mateusz Sarwa
+ * @date 2026-10-16
+ *
+ * A position's key is the XOR of one key per (piece, square), one for the
+ * castling rights, one for the en passant file and one when black is to
+ * move, so a move updates it with a handful of XORs. The keys come from a
+ * fixed-seed generator and are identical on every run and platform, which
+ * keeps stored keys valid between sessions.
+ */
+
+#pragma once
+#include <cstdint>
+#include "PieceCode.h"
+
+/**
+ * @class Zobrist
+ * @brief Key tables used by ChessBoard to maintain its position key
+ */
+class Zobrist {
+private:
+    static std::uint64_t pieceKeys[16][64];  ///< Keys per piece code and square (zero for NO_PIECE)
+    static std::uint64_t castlingKeys[16];   ///< Keys per combination of castling rights
+    static std::uint64_t enPassantKeys[8];   ///< Keys per en passant column
+    static std::uint64_t sideKey;            ///< Key added when black is to move
+
+public:
+    /**
+     * @brief Fills the key tables
+     *
+     * Safe to call any number of times from any thread; only the first
+     * call does work.
+     */
+    static void init();
+
+    /**
+     * @brief Returns the key of a piece on a square
+     * @param code Piece code (NO_PIECE gives 0)
+     * @param square Square index (0-63)
+     * @return Key to XOR in or out
+     */
+    static std::uint64_t piece(PieceCode code, int square) { return pieceKeys[code][square]; }
+
+    /**
+     * @brief Returns the key of a set of castling rights
+     * @param rights Combination of CastlingRight bits
+     * @return Key to XOR in or out
+     */
+    static std::uint64_t castling(int rights) { return castlingKeys[rights]; }
+
+    /**
+     * @brief Returns the key of an en passant column
+     * @param col Column (0-7)
+     * @return Key to XOR in or out
+     */
+    static std::uint64_t enPassant(int col) { return enPassantKeys[col]; }
+
+    /**
+     * @brief Returns the key added while black is to move
+     * @return Key to XOR in or out
+     */
+    static std::uint64_t side() { return sideKey; }
+};